@@ -7,7 +7,18 @@
 #include <stdio.h>
 #include <math.h>
 #include <limits.h>
+#include <stdint.h>
 #include <time.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <setjmp.h>
+#include <string.h>
+#include <dirent.h>
+#include <utime.h>
+#include <sys/stat.h>
 #include "getRSS.c"
 
 #ifdef DEBUG
@@ -16,11 +27,20 @@
 #define DEBUG_MSG(x) 
 #endif
 
+// with PACKED_MODEL, the values of the variables are kept only as two bits per
+// variable, packed into words, and the model holds the rest of each assignment
+#ifdef PACKED_MODEL
+#define PACKED_STATE X(uint64_t*, packed_model)
+#else
+#define PACKED_STATE
+#endif
+
 // MACROS
 
 // results
 #define UNSAT 0
 #define SAT 1
+#define UNKNOWN 2
 
 // truth values
 #define UNASSIGNED 0
@@ -31,11 +51,89 @@
 #define DEC_ASS 0
 #define PROP_ASS 1
 #define CON_ASS 2
+#define ELIM_ASS 3
+#define AMO_ASS 4
+
+// memory subsystems
+#define MEM_CLAUSES 0 // the clauses of the formula and the at-most-ones
+#define MEM_LEARNED 1
+#define MEM_WATCHES 2
+#define MEM_MODEL 3 // the model, the decision order and the phases
+#define MEM_TRAIL 4
+#define MEM_ANALYSIS 5
+#define MEM_PREPROCESSING 6 // including feature extraction
+#define MEM_EXTENSION 7 // the extension stack and the eliminated variables
+#define MEM_SEARCH 8 // the bit-sliced and local searches
+#define MEM_OTHER 9
+#define NUM_MEM 10
 
 // special values
 #define NULL_DEC_LEVEL ULONG_MAX - 1
 #define MAX_VARS ULONG_MAX / 2
 
+// preprocessing limits
+#define ELIM_OCC_LIMIT 32 // skip variables with more occurrences than this
+#define ELIM_CLS_LIMIT 24 // skip variables producing resolvents wider than this
+#define ELIM_ROUNDS 3
+#define AMO_MIN_SIZE 3 // smallest at-most-one constraint worth detecting
+
+// bit-sliced search limits
+#define SLICE_MAX_VARS 512 // larger formulas are left to the scalar search
+#define SLICE_WORDS 4 // 64 lanes per word
+#define SLICE_TIME_LIMIT 0.2 // seconds, beyond the budget of rounds
+#define SLICE_MAX_RESTARTS 32 // per lane on average
+
+// local search limits
+#define WALK_TIME_LIMIT 10 // seconds of wall time for the walkers together
+#define WALK_CHECK_INTERVAL 4096 // flips between two checks for a winner
+#define WALK_BREAK_MAX 64 // larger break counts share the last probability
+
+// portfolio limits
+#define EXCHANGE_SLOTS 4096 // clauses held by the ring buffer
+#define EXCHANGE_MAX_WIDTH 8 // widest learned clause that is shared
+#define RESTART_UNIT 100 // conflicts per unit of the luby sequence
+
+// result cache limits, 0 for no limit
+#define CACHE_MAX_ENTRIES 4096
+#define CACHE_MAX_BYTES (256UL << 20)
+#define CACHE_NAME_LENGTH 16 // hexadecimal digits of the formula hash
+
+// proof trimming limits
+#define TRIM_BLOCK (1 << 20) // bytes read from the proof at a time
+
+// interpolation
+#define ITP_FALSE 0
+#define ITP_TRUE 1
+#define ITP_NONE ULONG_MAX // no partial interpolant yet
+#define ITP_A 1 // variable classes, or-ed together
+#define ITP_B 2
+#define ITP_TABLE_MIN 1024 // initial size of the gate hash table
+
+// parallel propagation limits
+#define PAR_PROP_MIN 4096 // watchers of a literal worth splitting between threads
+#define PAR_MAX_THREADS 64
+#define PAR_KEEP ((lit_t)-1) // actions on the clauses of a split watch list
+#define PAR_UNIT ((lit_t)-2)
+
+// batch limits
+#define BATCH_TURN_STEPS 16 // steps of one formula before the next takes over
+
+// mini solver limits
+#define MINI_MAX 64 // variables and clauses, one bit each in a mini_set_t
+#define MINI_STEP_LIMIT 4096 // clause visits allowed per extraction
+
+// sweeping limits
+#define SIM_WORDS 4 // 64 random patterns per word
+
+// configuration selection limits
+#define NUM_FEATURES 13
+#define PROBE_LIMIT 64 // literals probed for the probing features
+#define MAX_CONFIGS 64 // centroids a selection model file may hold
+
+// lucky phase limits
+#define LUCKY_TIME_LIMIT 1.0 // seconds spent on all strategies together
+#define LUCKY_CHECK_INTERVAL 256 // decisions between two checks of the clock
+
 // low level types
 typedef unsigned char result_t;
 typedef signed char truth_value_t;
@@ -47,9 +145,41 @@ typedef unsigned long int model_size_t; // deprecate
 typedef unsigned long int mutable_size_t;
 typedef unsigned long int lit_t;
 typedef signed long int DIMACS_lit_t;
+typedef uint64_t mini_set_t;
+typedef uint64_t sim_word_t;
+typedef uint64_t slice_word_t;
+typedef unsigned char mem_t;
+
+// a solver configuration: the decision order and phases (jw scores, or the
+// input order and fixed phases), the luby restart unit (0 for no restarts),
+// and the preprocessing passes to run
+typedef struct config {
+  char name[32];
+  char jw_order;
+  truth_value_t phase; // UNASSIGNED for the jw phases
+  unsigned long restart_unit;
+  char amos;
+  char sweep;
+  char autarky;
+  char eliminate;
+} config_t;
 
 // stats
 clock_t start_time;
+// bytes currently allocated by each subsystem, and the peaks, also of the
+// total. progress_interval is the number of conflicts between two progress
+// lines, 0 for none
+size_t mem_bytes[NUM_MEM];
+size_t mem_peaks[NUM_MEM];
+size_t mem_total = 0;
+size_t mem_total_peak = 0;
+const char* mem_names[NUM_MEM] = {
+  "clauses", "learned", "watches", "model", "trail", "analysis",
+  "preprocessing", "extension", "search", "other"};
+unsigned long progress_interval = 0;
+// set by SIGUSR1, the statistics are printed at the next safe point
+volatile sig_atomic_t stats_requested = 0;
+const char* lucky_strategy = "none";
 
 // higher level types 
 
@@ -88,12 +218,18 @@ typedef struct mutable {
 // assignment
 
 // stores various information about a singleton assignment, including
-// a list of watched literals
+// a list of watched literals.
+// the reason of a propagated assignment is the clause that became unit; for an
+// assignment implied by an at-most-one constraint it points to the true literal
+// of the constraint instead
 
 typedef struct ass {
+#ifndef PACKED_MODEL
   truth_value_t truth_value;
+#endif
   dec_level_t dec_level;
   ass_type_t ass_type;
+  cls_t reason;
   mutable_t watched_lits;
 } ass_t;
 
@@ -103,6 +239,8 @@ typedef struct ass {
 // it is allocated as a fixed size array, since it size never exceeds
 // the number of variables
 // head and tail are pointers into the array used in propagation
+// assignments are written into the model as soon as they are added to the
+// trail, head marks the first assignment that is not yet propagated
 
 typedef struct trail {
   ass_t** sequence;
@@ -112,21 +250,518 @@ typedef struct trail {
 
 // global solver
 
+state_t state;
+dec_level_t dec_level;
 var_set_size_t num_vars;
 var_set_size_t num_asses;
 unsigned long num_conflicts = 0;
 unsigned long num_decisions = 0;
 unsigned long num_unit_props = 0;
 unsigned long num_redefinitions = 0;
+unsigned long num_eliminated = 0;
+unsigned long num_and_gates = 0;
+unsigned long num_xor_gates = 0;
+unsigned long num_ite_gates = 0;
+unsigned long num_equiv_gates = 0;
+unsigned long num_semantic_gates = 0;
+unsigned long num_swept = 0;
+unsigned long num_autarky_vars = 0;
+unsigned long num_autarky_clauses = 0;
+unsigned long num_walk_flips = 0;
+unsigned long num_split_props = 0;
+unsigned long num_slice_descents = 0;
+unsigned long num_restarts = 0;
+unsigned long num_exported = 0;
+unsigned long num_imported = 0;
+unsigned long num_amos = 0;
+unsigned long num_shrunk_levels = 0;
+unsigned long num_shrunk_lits = 0;
+unsigned long num_bin_minimized_lits = 0;
+// set when parsing or preprocessing finds the formula unsatisfiable, which is
+// reported once preprocessing has freed its data
+char unsat_found = 0;
 cnf_t cnf;
+cnf_size_t cnf_capacity; // clauses the cnf array can hold
 mutable_t learned_cnf;
+mutable_t amo_constraints;
+mutable_t* amo_watches = NULL;
 ass_t* model;
+#ifdef PACKED_MODEL
+// bit 0 of the pair of a variable is set if it is assigned, bit 1 if it is true
+uint64_t* packed_model;
+#endif
 trail_t trail;
-state_t stat;
+
+// conflict analysis state
+
+// the clause found falsified by propagation. a conflict on an at-most-one
+// constraint, and the reason of an assignment implied by one, are binary
+// clauses which are built in small static buffers
+cls_t conflict_cls;
+lit_t amo_conflict_cls[3];
+lit_t amo_reason_cls[3];
+
+// per variable marks, and scratch space for the learned clause and the marked
+// variables; level_counts counts the learned literals on each decision level
+char* seen;
+lit_t* learned_lits;
+lit_t* seen_vars;
+var_set_size_t num_seen_vars;
+var_set_size_t* level_counts;
+
+// per literal stamps for binary minimization, stamped with the conflict count
+unsigned long* bin_stamps;
+
+// interpolation state
+
+// the input clauses are split into A, the first itp_num_a of them, and B, the
+// rest. each clause of the cnf and each learned clause carries its partial
+// interpolant in a slot after its last literal. a partial interpolant is a
+// literal of an and-inverter graph: node n has the literals 2n and 2n + 1,
+// node 0 is the constant false, nodes 1 to itp_num_inputs are the variables
+// occurring in both A and B, and the other nodes are and gates, with their two
+// children in itp_nodes and hashed into itp_table. itp_classes tells whether a
+// variable occurs in A and in B, and itp_units holds the partial interpolant
+// of the unit that assigned a variable at level 0. the unit and empty input
+// clauses, which the cnf does not keep, are kept in itp_input_units, and the
+// one that makes the formula unsatisfiable while parsing in itp_conflict
+char* itp_filename = NULL;
+cnf_size_t itp_num_a;
+char* itp_classes;
+lit_t* itp_inputs;
+lit_t* itp_units;
+lit_t* itp_nodes;
+lit_t itp_num_nodes;
+lit_t itp_num_inputs;
+lit_t itp_capacity;
+lit_t* itp_table;
+lit_t itp_table_size;
+lit_t itp_num_written = 0;
+lit_t itp_learned; // the partial interpolant of the clause being learned
+mutable_t itp_input_units;
+cls_t itp_conflict = NULL;
+
+// proof state
+
+// the DRAT proof, written as text when requested. the clauses of the formula
+// are not repeated: the proof adds the learned clauses, the clauses derived by
+// preprocessing and at last the empty clause, and deletes the clauses that
+// preprocessing replaces or removes
+FILE* proof_file = NULL;
+char proof_path[PATH_MAX]; // absolute, empty if unknown
+
+// the proof checker keeps its own clauses and assignment, with the literals of
+// a variable numbered 2 * var and 2 * var + 1 for the negative one. as in the
+// model, check_watches[lit] holds the clauses watching the complement of lit,
+// which watch their first two literals. the clauses are also hashed by their
+// literals, so that a deletion finds its clause
+lit_t check_num_vars;
+signed char* check_values;
+mutable_t* check_watches;
+mutable_t* check_buckets;
+mutable_size_t check_num_buckets;
+mutable_size_t check_num_clauses;
+lit_t* check_trail;
+lit_t check_trail_size;
+lit_t check_head;
+lit_t* check_lits; // the clause read last
+var_set_size_t check_width;
+char check_tautology;
+unsigned long* check_stamps;
+unsigned long check_stamp;
+char check_refuted = 0;
+// when a DRAT proof is trimmed, the checker writes it as LRAT: every clause
+// has an id, the formula's from 1 and then the added ones in order, kept
+// after its literals. the top level assignments note their reasons, which
+// give the hints of every added clause in trail order
+FILE* check_lrat = NULL;
+unsigned long check_id; // of the clause read last
+unsigned long check_last_id;
+cls_t* check_reasons; // NULL for a unit clause
+unsigned long* check_reason_ids;
+lit_t* check_positions; // on the trail
+cls_t check_conflict;
+char* check_marks;
+unsigned long* check_hints;
+var_set_size_t check_num_hints;
+mutable_t check_kept; // deleted clauses that are reasons
+
+// decision state
+
+// the variables in the order they are decided, and the polarity each is
+// decided with. both come from Jeroslow-Wang scores of the input clauses,
+// which are accumulated per literal while parsing
+lit_t* var_order;
+truth_value_t* phases;
+double* jw_scores;
+
+// bit-sliced search state
+
+// SLICE_WORDS * 64 independent assignments, one per lane: bit b of word w of
+// a variable belongs to lane 64 * w + b. slice_pos and slice_neg mark the
+// lanes where the variable is true and false, slice_base_pos and
+// slice_base_neg hold the level 0 assignment every lane restarts from
+slice_word_t* slice_pos;
+slice_word_t* slice_neg;
+slice_word_t* slice_base_pos;
+slice_word_t* slice_base_neg;
+uint64_t slice_seed;
+
+// local search state
+
+// the clauses left after preprocessing, with the at-most-one constraints
+// expanded into binary clauses, in one read-only arena shared by the walkers:
+// clause c has the width walk_lits[walk_starts[c]] followed by its literals.
+// the clauses containing literal l are walk_occs[walk_occ_starts[l]] up to
+// walk_occs[walk_occ_starts[l + 1]]
+lit_t* walk_lits;
+cnf_size_t* walk_starts;
+cnf_size_t walk_num_clauses;
+cnf_size_t* walk_occ_starts;
+cnf_size_t* walk_occs;
+
+// each walker owns its assignment, the number of true literals of each clause
+// and the xor of their variables, which names the only true variable of a
+// clause with one true literal, the break count of each variable, and the
+// list of falsified clauses
+typedef struct walker {
+  pthread_t thread;
+  uint64_t seed;
+  double probs[WALK_BREAK_MAX + 1];
+  char* values;
+  var_set_size_t* breaks;
+  var_set_size_t* true_counts;
+  lit_t* true_xors;
+  cnf_size_t* unsat;
+  cnf_size_t* unsat_positions;
+  cnf_size_t num_unsat;
+  unsigned long flips;
+} walker_t;
+
+walker_t* walk_winner;
+pthread_mutex_t walk_mutex = PTHREAD_MUTEX_INITIALIZER;
+time_t walk_deadline;
+
+// parallel propagation state
+
+// with more than one thread, the watch list of a literal with at least
+// PAR_PROP_MIN clauses is split into as many ranges, which the main thread and
+// the helpers visit at once against the assignment as it was. the action on
+// each clause is PAR_KEEP, PAR_UNIT, or the literal that now watches it in
+// place of the propagator's complement. the main thread applies the actions
+// in order and stops assigning at the first conflict, so the outcome does not
+// depend on the number of threads
+int par_num_threads = 1;
+char par_running = 0;
+pthread_t par_threads[PAR_MAX_THREADS];
+int par_indices[PAR_MAX_THREADS];
+pthread_barrier_t par_start;
+pthread_barrier_t par_done;
+lit_t par_propagator;
+cls_t* par_data;
+cnf_size_t par_num_clauses;
+lit_t* par_actions = NULL;
+cnf_size_t par_capacity = 0;
+
+// portfolio state
+
+// the workers of a portfolio are forked after preprocessing and share the
+// formula copy-on-write. they exchange short learned clauses through a ring
+// buffer in shared memory: a worker takes a ticket by incrementing head, and
+// locks the slot of the ticket by setting its sequence number to the odd
+// 2 * ticket + 1, unless another writer holds it or a later ticket has used
+// it, in which case the clause is dropped. it publishes the slot with the even
+// 2 * ticket + 2, so no two publications of a slot share a number. a reader
+// that finds a sequence number other than the one it expects, before or after
+// copying the slot, skips it. the first worker to finish claims `winner' and
+// reports
+typedef struct exchange_slot {
+  unsigned long seq;
+  int worker;
+  lit_t width;
+  lit_t lits[EXCHANGE_MAX_WIDTH];
+} exchange_slot_t;
+
+typedef struct exchange {
+  int winner;
+  unsigned long head;
+  exchange_slot_t slots[EXCHANGE_SLOTS];
+} exchange_t;
+
+exchange_t* exchange = NULL;
+int worker_index = 0;
+int num_workers = 1;
+unsigned long exchange_cursor = 0;
+pid_t portfolio_parent;
+unsigned long restart_unit = 0;
+unsigned long restart_limit;
+unsigned long conflicts_since_restart = 0;
+
+// the clauses of the formula are moved into a single arena before the workers
+// are forked, each after its index, and are not written again, so that the
+// workers keep sharing its pages. a worker watches clause i of the arena with
+// its own watch_pairs[2i] and watch_pairs[2i + 1], rather than by moving the
+// watched literals to the front of the clause
+lit_t* arena = NULL;
+lit_t* arena_end = NULL;
+lit_t* watch_pairs = NULL;
+
+// batch state
+
+// the solver state of one formula, saved while other formulas of a batch take
+// their turns. the state of a formula is every global that outlives a single
+// propagation step
+#define INSTANCE_STATE \
+  X(clock_t, start_time) X(state_t, state) X(dec_level_t, dec_level) \
+  X(var_set_size_t, num_vars) X(var_set_size_t, num_asses) \
+  X(unsigned long, num_conflicts) X(unsigned long, num_decisions) \
+  X(unsigned long, num_unit_props) X(unsigned long, num_redefinitions) \
+  X(unsigned long, num_eliminated) X(unsigned long, num_and_gates) \
+  X(unsigned long, num_xor_gates) X(unsigned long, num_ite_gates) \
+  X(unsigned long, num_equiv_gates) X(unsigned long, num_semantic_gates) \
+  X(unsigned long, num_swept) X(unsigned long, num_autarky_vars) \
+  X(unsigned long, num_autarky_clauses) X(unsigned long, num_walk_flips) \
+  X(unsigned long, num_split_props) \
+  X(unsigned long, num_slice_descents) \
+  X(unsigned long, num_restarts) X(unsigned long, num_exported) \
+  X(unsigned long, num_imported) X(unsigned long, num_amos) \
+  X(unsigned long, num_shrunk_levels) X(unsigned long, num_shrunk_lits) \
+  X(unsigned long, num_bin_minimized_lits) X(char, unsat_found) \
+  X(cnf_t, cnf) X(mutable_t, learned_cnf) X(mutable_t, amo_constraints) \
+  X(mutable_t*, amo_watches) X(ass_t*, model) X(trail_t, trail) \
+  X(char*, seen) X(lit_t*, learned_lits) X(lit_t*, seen_vars) \
+  X(var_set_size_t*, level_counts) X(unsigned long*, bin_stamps) \
+  X(lit_t*, var_order) X(truth_value_t*, phases) \
+  X(mutable_t, extension_stack) X(char*, eliminated) \
+  X(lit_t*, reconstructed) X(lit_t, num_reconstructed) \
+  X(cls_t*, extension_occs) X(mutable_size_t*, extension_starts) \
+  X(mutable_size_t, extension_indexed) \
+  X(const char*, lucky_strategy) X(uint64_t, formula_hash) \
+  X(cnf_size_t, num_input_clauses) X(cnf_size_t, cnf_capacity) \
+  X(unsigned*, frozen) PACKED_STATE
+
+#define X(type, name) type name;
+typedef struct instance {
+  INSTANCE_STATE
+  char* filename;
+  char active;
+} instance_t;
+#undef X
+
+// in batch and incremental mode the report functions jump back to the caller
+// with the result instead of exiting
+jmp_buf report_jump;
+char report_returns = 0;
+result_t report_result;
+char incremental = 0;
+
+// the assumptions of the next incremental call, decided first, one on each
+// level, and whether the call failed because one of them was false
+lit_t* assumptions = NULL;
+var_set_size_t num_assumptions = 0;
+var_set_size_t assumptions_capacity = 0;
+char assumption_failed = 0;
+
+// bounded model checking state
+
+// an and-inverter graph read from an AIGER file, where variable v up to max_var
+// has the literals 2v and 2v + 1, and 0 and 1 are the constants. each latch has
+// its literal, the literal of its next state and its reset value: 0, 1, or its
+// own literal if uninitialised. each and gate has its literal and those of its
+// two children. bad is the literal of the property, and the constraints hold
+// in every frame
+typedef struct aiger {
+  unsigned long max_var;
+  unsigned long num_inputs;
+  unsigned long num_latches;
+  unsigned long num_ands;
+  unsigned long num_constraints;
+  unsigned long* inputs;
+  unsigned long* latches;
+  unsigned long* ands;
+  unsigned long* constraints;
+  unsigned long bad;
+} aiger_t;
+
+// configuration state
+
+// the configuration in use, the features of the formula, and the nearest
+// centroid of the selection model with its distance, negative if no
+// selection was made. the built-in model has a centroid for uniform random,
+// circuit and at-most-one heavy combinatorial formulas, measured on such
+// families, and a generic one; a model file replaces it
+config_t config = {"default", 1, UNASSIGNED, 0, 1, 1, 1, 1};
+double features[NUM_FEATURES];
+double config_distance = -1;
+const char* feature_names[NUM_FEATURES] = {
+  "vars", "clauses", "ratio", "binary", "ternary", "short", "long",
+  "degree-cv", "degree-max", "positive", "fixed", "implied", "failed"};
+config_t builtin_configs[] = {
+  {"default", 1, UNASSIGNED, 0, 1, 1, 1, 1},
+  {"random", 1, UNASSIGNED, 0, 0, 0, 1, 1},
+  {"circuit", 1, UNASSIGNED, 0, 1, 1, 1, 1},
+  {"combinatorial", 1, UNASSIGNED, 0, 1, 0, 1, 1}};
+double builtin_centroids[][NUM_FEATURES] = {
+  {0.30, 0.35, 0.60, 0.40, 0.40, 0.10, 0.10, 0.30, 0.30, 0.50, 0.05, 0.20, 0.10},
+  {0.31, 0.40, 0.79, 0.00, 1.00, 0.00, 0.00, 0.07, 0.14, 0.50, 0.00, 0.00, 0.00},
+  {0.38, 0.46, 0.73, 0.28, 0.68, 0.04, 0.00, 0.17, 0.25, 0.48, 0.00, 0.39, 0.02},
+  {0.30, 0.40, 0.85, 0.97, 0.00, 0.03, 0.00, 0.03, 0.12, 0.10, 0.00, 0.00, 0.00}};
+
+// result cache state
+
+// the hash of the formula as read, which does not depend on the order of the
+// clauses or of the literals in a clause, and the number of clauses in the
+// header. the cache keeps one file per formula, named after the hash, holding
+// the result and the model of a satisfiable formula, or for an unsatisfiable
+// one the path, size and time of the DRAT proof written with it, if any. the
+// least recently used files are evicted once the cache grows past its limits
+uint64_t formula_hash;
+cnf_size_t num_input_clauses;
+char* cache_dir = NULL;
+unsigned long cache_max_entries = CACHE_MAX_ENTRIES;
+unsigned long cache_max_bytes = CACHE_MAX_BYTES;
+const char* cache_status = "off";
+
+// mini solver state
+
+// the clauses of the mini solver, as bitsets of the local variables occurring
+// positively and negatively, and the variable each local variable stands for
+mini_set_t mini_pos[MINI_MAX];
+mini_set_t mini_neg[MINI_MAX];
+lit_t mini_vars[MINI_MAX];
+int mini_num_clauses;
+int mini_num_vars;
+unsigned long mini_steps;
+// with a proof, sweeping has the mini solver write the clause refuted by each
+// of its calls that ends in UNSAT
+char mini_proof = 0;
+
+// preprocessing state
+
+// eliminated clauses are kept on the extension stack for model reconstruction,
+// each with the literal of its eliminated variable moved to the front. a unit
+// on the stack is not a clause of the formula, but resets its variable
+mutable_t extension_stack;
+char* eliminated;
+// the eliminated variables that model reconstruction assigned, which the next
+// incremental call unassigns
+lit_t* reconstructed;
+lit_t num_reconstructed;
+// the clauses of the extension stack by variable, from extension_starts[var]
+// to extension_starts[var + 1], for the first extension_indexed clauses. a
+// reintroduced clause stays on the stack with width 0
+cls_t* extension_occs = NULL;
+mutable_size_t* extension_starts = NULL;
+mutable_size_t extension_indexed = 0;
+
+// per variable reference counts of CDCL_freeze, less those of CDCL_melt. a
+// frozen variable is kept in the formula by every simplification
+unsigned* frozen;
+
+// occurrence lists and literal stamps only live during preprocessing
+mutable_t pre_clauses;
+mutable_t* occs;
+unsigned long* lit_stamps;
+unsigned long stamp;
 
 // IMPLEMENTATION
 
 void error(char* message);
+uint64_t hash_mix(uint64_t value);
+lit_t itp_clause(cls_t cls);
+
+// MEMORY RELATED FUNCTIONS
+
+// every block is allocated with a header word in front, holding its size and
+// the subsystem it is accounted to, so that it can be reallocated and freed
+// without the caller knowing either. like malloc, the allocating functions
+// return NULL on failure. blocks are only allocated by the main thread
+
+void mem_account(mem_t subsystem, size_t added, size_t removed)
+{
+  mem_bytes[subsystem] += added - removed;
+  mem_total += added - removed;
+  if (mem_bytes[subsystem] > mem_peaks[subsystem])
+    mem_peaks[subsystem] = mem_bytes[subsystem];
+  if (mem_total > mem_total_peak)
+    mem_total_peak = mem_total;
+}
+
+void* mem_alloc(mem_t subsystem, size_t bytes)
+{
+  size_t* block;
+
+  if ((block = (size_t*)malloc(sizeof(size_t) + bytes)) == NULL)
+    return NULL;
+  *block = bytes * NUM_MEM + subsystem;
+  mem_account(subsystem, bytes, 0);
+  return block + 1;
+}
+
+void* mem_calloc(mem_t subsystem, size_t count, size_t bytes)
+{
+  size_t* block;
+
+  if ((block = (size_t*)calloc(1, sizeof(size_t) + count * bytes)) == NULL)
+    return NULL;
+  *block = count * bytes * NUM_MEM + subsystem;
+  mem_account(subsystem, count * bytes, 0);
+  return block + 1;
+}
+
+void* mem_realloc(void* data, size_t bytes)
+{
+  size_t* block = (size_t*)data - 1;
+  size_t header = *block;
+
+  if ((block = (size_t*)realloc(block, sizeof(size_t) + bytes)) == NULL)
+    return NULL;
+  *block = bytes * NUM_MEM + header % NUM_MEM;
+  mem_account(header % NUM_MEM, bytes, header / NUM_MEM);
+  return block + 1;
+}
+
+void mem_free(void* data)
+{
+  size_t* block = (size_t*)data - 1;
+
+  if (data == NULL)
+    return;
+  mem_account(*block % NUM_MEM, 0, *block / NUM_MEM);
+  free(block);
+}
+
+void mem_print(FILE* output)
+{
+  // prints the megabytes currently allocated by each subsystem that has
+  // allocated anything, with its peak
+  int subsystem;
+
+  for (subsystem = 0; subsystem < NUM_MEM; subsystem++)
+    if (mem_peaks[subsystem] > 0)
+      fprintf(output, " %s %.1f/%.1f", mem_names[subsystem],
+	      mem_bytes[subsystem] / 1048576.0, mem_peaks[subsystem] / 1048576.0);
+  fprintf(output, " total %.1f/%.1fMb", mem_total / 1048576.0,
+	  mem_total_peak / 1048576.0);
+}
+
+void print_progress()
+{
+  // one line on the state of the search and the memory of each subsystem
+  fprintf(stderr, "Progress:          %1.1lfs %lu conflicts, %lu learned, "
+	  "level %lu, trail %ld, memory",
+	  ((double)(clock() - start_time)) / CLOCKS_PER_SEC,
+	  num_conflicts, learned_cnf.used, dec_level, (long)(trail.tail - trail.sequence));
+  mem_print(stderr);
+  fprintf(stderr, "\n");
+}
+
+void stats_signal(int signal_number)
+{
+  // only sets the flag, as printing is not safe in a signal handler
+  (void)signal_number;
+  stats_requested = 1;
+}
 
 // LITERAL RELATED FUNCTIONS
 
@@ -147,10 +782,21 @@ DIMACS_lit_t lit_to_DIMACS(lit_t lit)
 }
 
 
-truth_value_t lit_truth_value(lit_t* lit)
+truth_value_t lit_value(lit_t lit)
 {
   // determines the truth value of the literal under the current assignment
-  return (model + *lit)->truth_value;
+#ifdef PACKED_MODEL
+  // without branches: the pair of the variable and the sign of the literal
+  // index a table of the values
+  static const truth_value_t values[8] = {UNASSIGNED, NEGATIVE, UNASSIGNED,
+    POSITIVE, UNASSIGNED, POSITIVE, UNASSIGNED, NEGATIVE};
+  lit_t negative = lit >= num_vars;
+  lit_t var = lit - (num_vars & -negative);
+
+  return values[((packed_model[var >> 5] >> ((var & 31) << 1)) & 3) | (negative << 2)];
+#else
+  return model[lit].truth_value;
+#endif
 }
 
 lit_t ass_to_lit(ass_t* ass)
@@ -165,6 +811,12 @@ lit_t get_comp_lit(lit_t lit)
   return lit + ((lit < num_vars? 1 : -1) * num_vars);
 }
 
+lit_t get_var(lit_t lit)
+{
+  // returns the variable of the literal, i.e. its positive literal
+  return (lit < num_vars) ? lit : lit - num_vars;
+}
+
 void lit_print(lit_t* lit)
 {
   //fprintf(stderr, "%lu", *lit);
@@ -187,13 +839,13 @@ void lit_print_binary(lit_t* lit)
 
 // CLAUSE RELATED FUNCTIONS
 
-cls_t cls_init(lit_t width)
+cls_t cls_init(lit_t width, mem_t subsystem)
 {
-  // initialises a clause of size `width'
+  // initialises a clause of size `width', accounted to the given subsystem
   // the fist `literal' is the size of the clause 
   cls_t cls;
 
-  if ((cls = (lit_t*)malloc(sizeof(lit_t) * (width + 1))) == NULL)
+  if ((cls = (lit_t*)mem_alloc(subsystem, sizeof(lit_t) * (width + 1))) == NULL)
     error("cannot allocate clause");
   cls[0] = width;
 
@@ -208,7 +860,40 @@ char cls_is_unit(cls_t cls)
 
 void cls_free(cls_t cls)
 {
-  free(cls);
+  mem_free(cls);
+}
+
+lit_t* cls_watches(cls_t cls)
+{
+  // returns the two watched literals of the clause: its first two, or its
+  // pair if it is in the arena
+  if (arena != NULL && cls > arena && cls < arena_end)
+    return watch_pairs + 2 * cls[-1];
+  return cls + 1;
+}
+
+cls_t cls_copy(cls_t cls, mem_t subsystem)
+{
+  // returns a newly allocated copy of the given clause
+  cls_t copy;
+  var_set_size_t which_lit;
+
+  copy = cls_init(cls[0], subsystem);
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    copy[which_lit] = cls[which_lit];
+
+  return copy;
+}
+
+char cls_is_satisfied(cls_t cls)
+{
+  // returns 1 if some literal of the clause is satisfied by the model, 0 otherwise
+  var_set_size_t which_lit;
+
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    if (lit_value(cls[which_lit]) == POSITIVE)
+      return 1;
+  return 0;
 }
 
 void cls_print(cls_t cls)
@@ -237,12 +922,24 @@ void cnf_print()
     }
 }
 
+void cnf_add(cls_t cls)
+{
+  // appends the clause to the cnf, doubling its array when it is full
+  if (cnf.size == cnf_capacity)
+    {
+      cnf_capacity = 2 * cnf_capacity + 1;
+      if ((cnf.clauses = (cls_t*)mem_realloc(cnf.clauses, sizeof(cls_t) * cnf_capacity)) == NULL)
+	error("cannot reallocate cnf clauses");
+    }
+  cnf.clauses[cnf.size++] = cls;
+}
+
 // MUTABLE RELATED FUNCTIONS
 
-void mutable_init(mutable_t* mutable)
+void mutable_init(mutable_t* mutable, mem_t subsystem)
 {
   // allocate memory for data - default size is 1
-  if ((mutable->data = (lit_t**)malloc(sizeof(lit_t*))) == NULL)
+  if ((mutable->data = (lit_t**)mem_alloc(subsystem, sizeof(lit_t*))) == NULL)
     error("cannot allocate mutable data");
 
   // set default member values
@@ -254,7 +951,7 @@ void mutable_init(mutable_t* mutable)
 void mutable_free(mutable_t* mutable)
 {
   // frees only the data of the pointed to mutable
-  free(mutable->data);
+  mem_free(mutable->data);
 }
 
 // use this to free learned cnf
@@ -267,7 +964,7 @@ void mutable_free_clauses(mutable_t* mutable)
   num_clauses = mutable->used;
   for(which_clause = 0; which_clause < num_clauses; which_clause++)
     cls_free(mutable->data[which_clause]);
-  free(mutable->data);
+  mem_free(mutable->data);
 }
 
 void mutable_push(mutable_t* mutable, lit_t* datum)
@@ -278,7 +975,7 @@ void mutable_push(mutable_t* mutable, lit_t* datum)
   if (mutable->used == (size = mutable->size))
     {
       if ((mutable->data = 
-	   (lit_t**)realloc(mutable->data, 2 * size * sizeof(lit_t*))) == NULL)
+	   (lit_t**)mem_realloc(mutable->data, 2 * size * sizeof(lit_t*))) == NULL)
 	error("cannot reallocate mutable data");
       mutable->size = 2 * size;
       mutable->data[mutable->used++] = datum;
@@ -338,27 +1035,47 @@ void print_watched_lits()
 
 // ASSIGNMENT RELATED FUNCTIONS
 
+void value_set(lit_t lit, truth_value_t value)
+{
+  // sets the value of the literal, and the opposite value of its complement
+#ifdef PACKED_MODEL
+  lit_t var = get_var(lit);
+  unsigned shift = (var & 31) << 1;
+  uint64_t bits = value == UNASSIGNED ? 0 : (value == POSITIVE) == (lit == var) ? 3 : 1;
+
+  packed_model[var >> 5] = (packed_model[var >> 5] & ~((uint64_t)3 << shift)) | (bits << shift);
+#else
+  model[lit].truth_value = value;
+  model[get_comp_lit(lit)].truth_value = -value;
+#endif
+}
+
 void assign_by_lit(lit_t lit)
 {
   // overwrites the assignment satisfying the literal into the model
   // the assignment type should already have been set when the literal
   // was added to the trail
+  value_set(lit, POSITIVE);
+  model[lit].dec_level = dec_level;
+  model[get_comp_lit(lit)].dec_level = dec_level;
+}
+
+void assign_eliminated(lit_t lit)
+{
+  // sets the value of an eliminated variable during model reconstruction
   lit_t comp_lit = get_comp_lit(lit);
 
-  model[lit].truth_value = POSITIVE;
-  model[lit].dec_level = dec_level;
-  model[comp_lit].truth_value = NEGATIVE;
-  model[comp_lit].dec_level = dec_level;
+  value_set(lit, POSITIVE);
+  model[lit].dec_level = NULL_DEC_LEVEL;
+  model[lit].ass_type = ELIM_ASS;
+  model[comp_lit].dec_level = NULL_DEC_LEVEL;
+  model[comp_lit].ass_type = ELIM_ASS;
 }
 
 void unassign_by_lit(lit_t lit)
 {
   // unassigns the variable for this literal (i.e. for the literal and its complement)
-  // 
-  lit_t comp_lit = get_comp_lit(lit);
-
-  model[lit].truth_value = UNASSIGNED;
-  model[comp_lit].truth_value = UNASSIGNED;
+  value_set(lit, UNASSIGNED);
 }
 
 // prints the value of an assignment and its decision level
@@ -366,11 +1083,11 @@ void ass_print(ass_t* ass)
 {
   dec_level_t dec_level = ass->dec_level;
 
-  if(ass->truth_value == UNASSIGNED)
+  if(lit_value(ass_to_lit(ass)) == UNASSIGNED)
     fprintf(stderr, "0 ");
   else
     {
-      fprintf(stderr, "%2d / %ld ", ass->truth_value,
+      fprintf(stderr, "%2d / %ld ", lit_value(ass_to_lit(ass)),
 	      dec_level == NULL_DEC_LEVEL ? -1L : (long)dec_level);
       switch(ass->ass_type)
 	{
@@ -383,26 +1100,33 @@ void ass_print(ass_t* ass)
 	case CON_ASS:
 	  fprintf(stderr, "C ");
 	  break;
+	case ELIM_ASS:
+	  fprintf(stderr, "E ");
+	  break;
+	case AMO_ASS:
+	  fprintf(stderr, "A ");
+	  break;
 	default:
 	  break;
 	}
     }
 }
 
-// this function assumes trail.head > trail.sequence
+// removes all assignments above the given decision level from the trail and
+// the model
 void backtrack(dec_level_t new_dec_level)
 {  
   DEBUG_MSG(fprintf(stderr,
 		    "In backtrack(). Backtracking to decision level %lu.\n",
 		    new_dec_level));
   // go backwards through the trail and delete the assignments
-  while((trail.head >= trail.sequence) && ((*(trail.head))->dec_level > new_dec_level))
+  while((trail.tail > trail.sequence) &&
+	((*(trail.tail - 1))->dec_level > new_dec_level))
     {
-      unassign_by_lit(*trail.head - model);
-      trail.head--;
+      trail.tail--;
+      unassign_by_lit(*trail.tail - model);
     }
-  trail.head++;
-  trail.tail = trail.head;
+  trail.head = trail.tail;
   //revert to given decision level
   dec_level = new_dec_level;
 }
@@ -425,6 +1149,31 @@ void print_model()
     }
   fprintf(stderr, "\n");
 }
+
+// extends the model to the eliminated variables
+// the extension stack is walked backwards, and the eliminated literal at the
+// front of every clause that is not yet satisfied is flipped to true
+void reconstruct_model()
+{
+  var_set_size_t which_var;
+  mutable_size_t which_clause;
+  cls_t cls;
+
+  // eliminated variables default to false
+  for (which_var = 0; which_var < num_vars; which_var++)
+    if (eliminated[which_var] && lit_value(which_var) == UNASSIGNED)
+      {
+	reconstructed[num_reconstructed++] = which_var;
+	assign_eliminated(get_comp_lit(which_var));
+      }
+
+  for (which_clause = extension_stack.used; which_clause > 0; which_clause--)
+    {
+      cls = extension_stack.data[which_clause - 1];
+      if (cls[0] > 0 && !cls_is_satisfied(cls))
+	assign_eliminated(cls[1]);
+    }
+}
  
 // TRAIL RELATED FUNCTIONS
 
@@ -434,10 +1183,18 @@ void trail_add_ass(ass_t* ass)
   trail.tail++;
 }
 
-void trail_add_lit(lit_t lit, ass_type_t ass_type)
+void trail_add_lit(lit_t lit, ass_type_t ass_type, cls_t reason)
 {
+  // assigns the literal at the current decision level and adds it to the
+  // trail for propagation. a literal implied at level 0 gets the partial
+  // interpolant of its unit
+  if (itp_filename != NULL && dec_level == 0 && reason != NULL)
+    itp_units[get_var(lit)] = itp_clause(reason);
   model[lit].ass_type = ass_type;
   model[get_comp_lit(lit)].ass_type = ass_type;
+  model[lit].reason = reason;
+  model[get_comp_lit(lit)].reason = reason;
+  assign_by_lit(lit);
   *(trail.tail) = model + lit;
   trail.tail++;
 }
@@ -459,7 +1216,7 @@ void print_trail()
       fprintf(stderr, "%lu: %ld ",
 	      temp_pointer - trail.sequence + 1,
 	      lit_to_DIMACS(*temp_pointer - model));
-      if ((*temp_pointer)->truth_value == UNASSIGNED)
+      if (lit_value(ass_to_lit(*temp_pointer)) == UNASSIGNED)
 	fprintf(stderr, "U ");
       else switch((*temp_pointer)->ass_type)
 	     {
@@ -472,6 +1229,9 @@ void print_trail()
 	     case CON_ASS:
 	       fprintf(stderr, "C ");
 	       break;	
+	     case AMO_ASS:
+	       fprintf(stderr, "A ");
+	       break;
 	     default:
 	       break;
 	     }
@@ -482,153 +1242,5434 @@ void print_trail()
   fprintf(stderr, "\n");
 }
 
-// CDCL INTERFACE IMPLEMENTATION
+// AT-MOST-ONE RELATED FUNCTIONS
 
-void  CDCL_print_stats()
-{
-  fprintf(stderr, "Conflicts:         %lu\n", num_conflicts);
-  fprintf(stderr, "Decisions:         %lu\n", num_decisions);
-  fprintf(stderr, "Unit Propagations: %lu\n", num_unit_props);
-  //fprintf(stderr, "Redefinitions:     %lu\n", num_redefinitions);
-  fprintf(stderr, "%1.1lfs ", ((double)(clock() - start_time)) / CLOCKS_PER_SEC);
-  fprintf(stderr, "%1.1zdMb ", getPeakRSS() / 1048576);
-  fprintf(stderr, "\n");
-}
+// an at-most-one constraint has the layout of a clause: the width followed by
+// its literals, at most one of which may be true.
+// instead of the quadratic number of binary clauses it replaces, each constraint
+// is watched once by each of its literals: amo_watches[lit] lists the
+// constraints containing lit. the watches are only allocated once the first
+// constraint is added
 
-void CDCL_report_SAT()
+void amo_add(lit_t* lits, var_set_size_t width)
 {
-  print_model();
-  fprintf(stderr, "v SAT\n");
-  CDCL_print_stats();
-  exit(0);
+  // adds an at-most-one constraint over the given literals
+  model_size_t which_ass;
+  var_set_size_t which_lit;
+  cls_t amo;
+
+  if (amo_watches == NULL)
+    {
+      if ((amo_watches = (mutable_t*)mem_alloc(MEM_WATCHES, sizeof(mutable_t) * num_asses)) == NULL)
+	error("cannot allocate at-most-one watches");
+      for (which_ass = 0; which_ass < num_asses; which_ass++)
+	mutable_init(amo_watches + which_ass, MEM_WATCHES);
+    }
+
+  amo = cls_init(width, MEM_CLAUSES);
+  for (which_lit = 1; which_lit <= width; which_lit++)
+    {
+      amo[which_lit] = lits[which_lit - 1];
+      mutable_push(amo_watches + amo[which_lit], amo);
+    }
+  mutable_push(&amo_constraints, amo);
+  num_amos++;
 }
-void CDCL_report_UNSAT()
+
+char var_in_amo(lit_t var)
 {
-  fprintf(stderr, "v UNSAT\n");
-  CDCL_print_stats();
-  exit(0);
+  // returns 1 if either literal of the variable occurs in an at-most-one
+  // constraint, 0 otherwise
+  return amo_watches != NULL &&
+    (amo_watches[var].used > 0 || amo_watches[get_comp_lit(var)].used > 0);
 }
 
-// initialises global solver according to the DIMACS file 'input'.
-void CDCL_init(char* DIMACS_filename)
+state_t amo_prop(lit_t propagator)
 {
-  FILE* input, *cursor;
-  char buffer[5]; // used only to read the `cnf' string from the input file
-  char ch; // used to read single characters from the input file  
-  DIMACS_lit_t DIMACS_lit; // temporary literal for reading
-  var_set_size_t width; 
-  var_set_size_t which_lit; 
-  var_set_size_t which_ass; 
-  cnf_size_t which_clause;
-  cls_t cls;
+  // falsifies the other literals of every at-most-one constraint containing
+  // the propagator. returns CONFLICT if one of them is already true, with the
+  // binary clause excluding the two literals as conflict clause
+  mutable_t* watches = amo_watches + propagator;
+  mutable_size_t which_amo;
+  var_set_size_t which_lit;
+  lit_t* reason;
+  cls_t amo;
 
-  start_time = clock();
-  state = DECIDE;
+  for (which_amo = 0; which_amo < watches->used; which_amo++)
+    {
+      amo = watches->data[which_amo];
+      // the reason of the implied assignments points to the propagator within
+      // the constraint
+      for (reason = amo + 1; *reason != propagator; reason++)
+	continue;
+      for (which_lit = 1; which_lit <= amo[0]; which_lit++)
+	{
+	  if (amo[which_lit] == propagator)
+	    continue;
+	  switch (lit_value(amo[which_lit]))
+	    {
+	    case POSITIVE:
+	      DEBUG_MSG(fprintf(stderr, "at-most-one conflict on %ld\n",
+				lit_to_DIMACS(amo[which_lit])));
+	      amo_conflict_cls[0] = 2;
+	      amo_conflict_cls[1] = get_comp_lit(propagator);
+	      amo_conflict_cls[2] = get_comp_lit(amo[which_lit]);
+	      conflict_cls = amo_conflict_cls;
+	      return CONFLICT;
+	    case UNASSIGNED:
+	      num_unit_props++;
+	      trail_add_lit(get_comp_lit(amo[which_lit]), AMO_ASS, reason);
+	      break;
+	    default:
+	      break;
+	    }
+	}
+    }
+  return DECIDE;
+}
 
-  // open file connections
-  // TODO: currently using two file connections to find size of clauses before writing
-  // them; it is probably possible to use just one, and to traverse the stream 
-  // backwards when needed
-  if ((input = (FILE *)fopen(DIMACS_filename, "r")) == NULL) error("cannot open file");
-  if ((cursor = (FILE *)fopen(DIMACS_filename, "r")) == NULL) error("cannot open file");
+// INTERPOLATION RELATED FUNCTIONS
 
-  // parse header
-  // disregard comment lines
-  while ((ch = fgetc(input)) == 'c')
-    while ((ch = fgetc(input)) != '\n')
-      continue;
-  while ((ch = fgetc(cursor)) == 'c')
-    while ((ch = fgetc(cursor)) != '\n')
-      continue;
-  // read header line
-  if (ch != 'p') error("bad input - 'p' not found");
-  if ((fscanf(input, "%s", buffer)) != 1) error("bad input - 'cnf' not found");
-  fscanf(cursor, "%s", buffer);
+// the partial interpolants follow McMillan's system: an A clause starts with
+// the disjunction of its literals over shared variables and a B clause with
+// true; resolving on a variable local to A takes the disjunction of the
+// partial interpolants, and on any other variable their conjunction. the
+// partial interpolant of the empty clause is an interpolant of A and B
 
-  // read number of variables
-  if ((fscanf(input, "%lu", &(num_vars))) != 1)
-    error("bad input - number of vars missing");
-  fscanf(cursor, "%lu", &(num_vars));
-  if (num_vars > pow(2,(sizeof(lit_t) * 8) - 3) - 1) // i.e. more variables than our data type can handle
-    error("too many vars");
-  num_asses = num_vars * 2;
+lit_t* cls_itp(cls_t cls)
+{
+  // the slot of the partial interpolant, after the last literal
+  return cls + cls[0] + 1;
+}
 
-  // initialise model
-  if ((model = (ass_t*)malloc(sizeof(ass_t) * num_asses)) == NULL)
-	error("cannot allocate model");
-  for (which_ass = 0; which_ass < num_asses; which_ass++)
+lit_t itp_new_node(lit_t lit, lit_t other_lit)
+{
+  // appends a node with the given children and returns its index
+  if (itp_num_nodes == itp_capacity)
     {
-      // set default values and initialise watched literals mutable for each assignment
-      model[which_ass].truth_value = UNASSIGNED; 
-      mutable_init(&(model[which_ass].watched_lits));
+      itp_capacity *= 2;
+      if ((itp_nodes = (lit_t*)mem_realloc(itp_nodes, sizeof(lit_t) * 2 * itp_capacity)) == NULL)
+	error("cannot reallocate interpolant nodes");
     }
+  itp_nodes[2 * itp_num_nodes] = lit;
+  itp_nodes[2 * itp_num_nodes + 1] = other_lit;
+  return itp_num_nodes++;
+}
 
-  // initialise trail
-  if ((trail.sequence = (ass_t**)malloc(sizeof(ass_t*) * num_asses)) == NULL)
-	error("cannot allocate trail sequence");
-  trail.head = trail.sequence;
-  trail.tail = trail.sequence;
+lit_t itp_slot(lit_t lit, lit_t other_lit)
+{
+  // the slot of the gate with the given children in the hash table, or the
+  // empty slot where it belongs
+  lit_t slot, node;
 
-  // read number of clauses
-  if(fscanf(input, "%lu", &cnf.size) != 1)
-    error("bad input - number of clauses not found");
-  fscanf(cursor, "%lu", &cnf.size);
+  slot = hash_mix((lit << 32) ^ other_lit) & (itp_table_size - 1);
+  while ((node = itp_table[slot]) != 0 &&
+	 (itp_nodes[2 * node] != lit || itp_nodes[2 * node + 1] != other_lit))
+    slot = (slot + 1) & (itp_table_size - 1);
+  return slot;
+}
 
-  // initialise cnf
-  if ((cnf.clauses = (cls_t*)malloc(sizeof(cls_t) * cnf.size)) == NULL)
-	error("cannot allocate cnf clauses");
+void itp_rehash()
+{
+  // doubles the hash table and reinserts the gates
+  lit_t node;
 
-  // allocate clauses and add to formula
-  for(which_clause = 0; which_clause < cnf.size; which_clause++)
-    {
-      // find width of clause with cursor
-      fscanf(cursor, "%ld", &DIMACS_lit);
-      for(width = 0; DIMACS_lit != 0; width++) fscanf(cursor, "%ld", &DIMACS_lit);
+  mem_free(itp_table);
+  itp_table_size *= 2;
+  if ((itp_table = (lit_t*)mem_calloc(MEM_ANALYSIS, itp_table_size, sizeof(lit_t))) == NULL)
+    error("cannot allocate interpolant table");
+  for (node = itp_num_inputs + 1; node < itp_num_nodes; node++)
+    itp_table[itp_slot(itp_nodes[2 * node], itp_nodes[2 * node + 1])] = node;
+}
 
-      // if the width is 0, note that the formula is UNSAT and return
-      if (width == 0)
-	{
-	  CDCL_report_UNSAT();
-	  exit(0);
-	}
+lit_t itp_and(lit_t lit, lit_t other_lit)
+{
+  // returns the conjunction of the two literals. constants and repeated or
+  // complementary literals are folded, and each gate is built only once
+  lit_t temp_lit, slot;
 
-      // if the width is 1, add the assignment as a level 0 unit propagation
-      if (width == 1)
-	{
-	  fscanf(input, "%ld", &DIMACS_lit);
-	  trail_add_lit(DIMACS_to_lit(DIMACS_lit), PROP_ASS);
+  if (lit < other_lit)
+    {
+      temp_lit = lit;
+      lit = other_lit;
+      other_lit = temp_lit;
+    }
+  if (other_lit == ITP_FALSE || lit == (other_lit ^ 1))
+    return ITP_FALSE;
+  if (other_lit == ITP_TRUE || lit == other_lit)
+    return lit;
+  slot = itp_slot(lit, other_lit);
+  if (itp_table[slot] != 0)
+    return 2 * itp_table[slot];
+  itp_table[slot] = itp_new_node(lit, other_lit);
+  if (2 * (itp_num_nodes - itp_num_inputs) > itp_table_size)
+    itp_rehash();
+  return 2 * (itp_num_nodes - 1);
+}
+
+lit_t itp_resolve(lit_t itp, lit_t other_itp, lit_t var)
+{
+  // the partial interpolant of a resolvent on the variable
+  if (itp_classes[var] == ITP_A)
+    return itp_and(itp ^ 1, other_itp ^ 1) ^ 1;
+  return itp_and(itp, other_itp);
+}
+
+lit_t itp_clause(cls_t cls)
+{
+  // the partial interpolant of the clause resolved with the units of its
+  // literals false at level 0
+  var_set_size_t which_lit;
+  lit_t itp, lit;
+
+  itp = *cls_itp(cls);
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    {
+      lit = cls[which_lit];
+      if (lit_value(lit) == NEGATIVE && model[lit].dec_level == 0)
+	itp = itp_resolve(itp, itp_units[get_var(lit)], get_var(lit));
+    }
+  return itp;
+}
+
+void itp_input_clause(cls_t cls, char in_a)
+{
+  // marks the side of the variables of an input clause, and keeps the side in
+  // the slot of its partial interpolant until itp_init
+  var_set_size_t which_lit;
+
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    itp_classes[get_var(cls[which_lit])] |= in_a ? ITP_A : ITP_B;
+  *cls_itp(cls) = in_a;
+}
+
+void itp_set_partial(cls_t cls)
+{
+  // replaces the side of an input clause by its partial interpolant
+  var_set_size_t which_lit;
+  lit_t itp, lit;
+
+  if (!*cls_itp(cls))
+    {
+      *cls_itp(cls) = ITP_TRUE;
+      return;
+    }
+  itp = ITP_FALSE;
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    {
+      lit = cls[which_lit];
+      if (itp_classes[get_var(lit)] == (ITP_A | ITP_B))
+	itp = itp_and(itp ^ 1, itp_inputs[get_var(lit)] ^ (lit == get_var(lit))) ^ 1;
+    }
+  *cls_itp(cls) = itp;
+}
+
+void itp_init()
+{
+  // makes the shared variables the inputs of the graph, and gives the input
+  // clauses their partial interpolants and the input units theirs
+  cnf_size_t which_clause;
+  mutable_size_t which_unit;
+  lit_t var, lit;
+  cls_t cls;
+
+  itp_capacity = num_vars + 1;
+  for (var = 0; var < num_vars; var++)
+    itp_capacity += itp_classes[var] == (ITP_A | ITP_B);
+  itp_table_size = ITP_TABLE_MIN;
+  if ((itp_nodes = (lit_t*)mem_alloc(MEM_ANALYSIS, sizeof(lit_t) * 2 * itp_capacity)) == NULL ||
+      (itp_table = (lit_t*)mem_calloc(MEM_ANALYSIS, itp_table_size, sizeof(lit_t))) == NULL)
+    error("cannot allocate interpolant");
+  itp_num_nodes = 0;
+  itp_new_node(ITP_FALSE, ITP_FALSE);
+  for (var = 0; var < num_vars; var++)
+    if (itp_classes[var] == (ITP_A | ITP_B))
+      itp_inputs[var] = 2 * itp_new_node(ITP_FALSE, ITP_FALSE);
+  itp_num_inputs = itp_num_nodes - 1;
+
+  for (which_clause = 0; which_clause < cnf.size; which_clause++)
+    itp_set_partial(cnf.clauses[which_clause]);
+  for (which_unit = 0; which_unit < itp_input_units.used; which_unit++)
+    {
+      cls = itp_input_units.data[which_unit];
+      itp_set_partial(cls);
+      if (cls[0] == 0)
+	{
+	  if (itp_conflict == NULL)
+	    itp_conflict = cls;
+	  continue;
+	}
+      // the first unit of a variable assigned it, a later complementary one
+      // is a conflict
+      lit = cls[1];
+      if (itp_units[get_var(lit)] == ITP_NONE)
+	itp_units[get_var(lit)] = *cls_itp(cls);
+      else if (lit_value(lit) == NEGATIVE && itp_conflict == NULL)
+	itp_conflict = cls;
+    }
+}
+
+void itp_write_delta(FILE* output, lit_t delta)
+{
+  // writes a number in the variable length encoding of binary AIGER
+  while (delta >= 0x80)
+    {
+      fputc((int)((delta & 0x7f) | 0x80), output);
+      delta >>= 7;
+    }
+  fputc((int)delta, output);
+}
+
+void itp_write(lit_t itp)
+{
+  // writes the interpolant as binary AIGER with the gates of its cone only.
+  // the inputs are the shared variables in order, named by their DIMACS
+  // variables in the symbol table
+  FILE* output;
+  lit_t* renamed;
+  lit_t node, lit, other_lit, num_gates, which_input;
+  lit_t var;
+
+  if ((renamed = (lit_t*)mem_calloc(MEM_ANALYSIS, itp_num_nodes, sizeof(lit_t))) == NULL)
+    error("cannot allocate interpolant renaming");
+  // children come before their gates, so one backward pass marks the cone
+  renamed[itp >> 1] = 1;
+  for (node = itp_num_nodes - 1; node > itp_num_inputs; node--)
+    if (renamed[node])
+      {
+	renamed[itp_nodes[2 * node] >> 1] = 1;
+	renamed[itp_nodes[2 * node + 1] >> 1] = 1;
+      }
+  for (node = 0; node <= itp_num_inputs; node++)
+    renamed[node] = node;
+  num_gates = 0;
+  for (node = itp_num_inputs + 1; node < itp_num_nodes; node++)
+    if (renamed[node])
+      renamed[node] = itp_num_inputs + ++num_gates;
+
+  if ((output = fopen(itp_filename, "wb")) == NULL)
+    error("cannot open interpolant file");
+  fprintf(output, "aig %lu %lu 0 1 %lu\n%lu\n", itp_num_inputs + num_gates,
+	  itp_num_inputs, num_gates, 2 * renamed[itp >> 1] + (itp & 1));
+  for (node = itp_num_inputs + 1; node < itp_num_nodes; node++)
+    if (renamed[node])
+      {
+	lit = 2 * renamed[itp_nodes[2 * node] >> 1] + (itp_nodes[2 * node] & 1);
+	other_lit = 2 * renamed[itp_nodes[2 * node + 1] >> 1] +
+	  (itp_nodes[2 * node + 1] & 1);
+	itp_write_delta(output, 2 * renamed[node] - lit);
+	itp_write_delta(output, lit - other_lit);
+      }
+  which_input = 0;
+  for (var = 0; var < num_vars; var++)
+    if (itp_classes[var] == (ITP_A | ITP_B))
+      fprintf(output, "i%lu %ld\n", which_input++, lit_to_DIMACS(var));
+  fprintf(output, "o0 interpolant\nc\ninterpolant of the first %lu clauses and the rest\n",
+	  itp_num_a);
+  fclose(output);
+  mem_free(renamed);
+  itp_num_written = num_gates;
+}
+
+// PROOF RELATED FUNCTIONS
+
+// every clause added to the proof is implied by unit propagation on the
+// clauses before it. the clauses of at-most-one encodings stay in the proof
+// after they are lifted into constraints, and justify the propagations of the
+// constraints
+
+void proof_write(char deletion, lit_t* lits, var_set_size_t width)
+{
+  // writes the addition or the deletion of the clause, if a proof is written
+  var_set_size_t which_lit;
+
+  if (proof_file == NULL)
+    return;
+  if (deletion)
+    fputs("d ", proof_file);
+  for (which_lit = 0; which_lit < width; which_lit++)
+    fprintf(proof_file, "%ld ", lit_to_DIMACS(lits[which_lit]));
+  fputs("0\n", proof_file);
+}
+
+void proof_add(lit_t* lits, var_set_size_t width)
+{
+  proof_write(0, lits, width);
+}
+
+void proof_delete(lit_t* lits, var_set_size_t width)
+{
+  proof_write(1, lits, width);
+}
+
+void proof_strengthen(cls_t cls)
+{
+  // replaces the clause in the proof by the clause without its literals false
+  // at level 0, if it has any
+  var_set_size_t which_lit;
+
+  if (proof_file == NULL)
+    return;
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    if (lit_value(cls[which_lit]) == NEGATIVE)
+      break;
+  if (which_lit > cls[0])
+    return;
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    if (lit_value(cls[which_lit]) != NEGATIVE)
+      fprintf(proof_file, "%ld ", lit_to_DIMACS(cls[which_lit]));
+  fputs("0\n", proof_file);
+  proof_delete(cls + 1, cls[0]);
+}
+
+// CONFLICT ANALYSIS RELATED FUNCTIONS
+
+cls_t get_reason(lit_t lit)
+{
+  // returns the clause that implied the (true) literal. for a literal implied
+  // by an at-most-one constraint this is the binary clause (-a lit), where a is
+  // the true literal of the constraint
+  if (model[lit].ass_type != AMO_ASS)
+    return model[lit].reason;
+  amo_reason_cls[0] = 2;
+  amo_reason_cls[1] = lit;
+  amo_reason_cls[2] = get_comp_lit(*(model[lit].reason));
+  return amo_reason_cls;
+}
+
+void mark_seen(lit_t lit)
+{
+  // marks the variable of the literal, remembering it for unmarking
+  seen[get_var(lit)] = 1;
+  seen_vars[num_seen_vars++] = get_var(lit);
+}
+
+var_set_size_t analyse_conflict()
+{
+  // resolves the conflict clause with the reasons of the assignments on the
+  // conflict level, in reverse trail order, until a single literal of that
+  // level is left: the first UIP. the learned clause is written into
+  // learned_lits with the negated UIP first, and its width is returned
+  var_set_size_t width = 1, which_lit, open = 0;
+  ass_t** temp_tail = trail.tail;
+  cls_t cls = conflict_cls;
+  lit_t lit, uip;
+
+  if (itp_filename != NULL)
+    itp_learned = itp_clause(cls);
+  while (1)
+    {
+      // mark the new literals, the resolved literal is already marked
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	{
+	  lit = cls[which_lit];
+	  if (seen[get_var(lit)] || model[lit].dec_level == 0)
+	    continue;
+	  mark_seen(lit);
+	  if (model[lit].dec_level == dec_level)
+	    open++;
+	  else
+	    learned_lits[width++] = lit;
+	}
+
+      // find the last marked assignment on the trail
+      do
+	temp_tail--;
+      while (!seen[get_var(*temp_tail - model)]);
+      uip = *temp_tail - model;
+      if (--open == 0)
+	break;
+      cls = get_reason(uip);
+      if (itp_filename != NULL)
+	itp_learned = itp_resolve(itp_learned, itp_clause(cls), get_var(uip));
+    }
+  learned_lits[0] = get_comp_lit(uip);
+  return width;
+}
+
+var_set_size_t shrink_learned(var_set_size_t width)
+{
+  // replaces the literals of each lower decision level in the learned clause
+  // by a single UIP of that level. the trail is walked backwards through the
+  // level, resolving the marked literals with their reasons until one is left;
+  // this fails if a reason brings in a literal of an even lower level that is
+  // not already in the clause. returns the new width
+  var_set_size_t which_lit, kept, open;
+  ass_t** temp_tail = trail.tail;
+  dec_level_t level;
+  char shrinkable;
+  lit_t lit, other, level_itp;
+  cls_t reason;
+
+  // count the literals on each level
+  for (which_lit = 1; which_lit < width; which_lit++)
+    level_counts[model[learned_lits[which_lit]].dec_level]++;
+
+  // the conflict level holds the first UIP only, so it is skipped
+  while (temp_tail > trail.sequence && (*(temp_tail - 1))->dec_level == dec_level)
+    temp_tail--;
+
+  while (temp_tail > trail.sequence && (level = (*(temp_tail - 1))->dec_level) > 0)
+    {
+      if (level_counts[level] > 1)
+	{
+	  open = level_counts[level];
+	  shrinkable = 1;
+	  level_itp = itp_learned;
+	  while (1)
+	    {
+	      lit = *(--temp_tail) - model;
+	      if (!seen[get_var(lit)])
+		continue;
+	      if (open-- == 1)
+		break;
+	      reason = get_reason(lit);
+	      if (itp_filename != NULL)
+		level_itp = itp_resolve(level_itp, itp_clause(reason), get_var(lit));
+	      for (which_lit = 1; which_lit <= reason[0]; which_lit++)
+		{
+		  other = reason[which_lit];
+		  if (seen[get_var(other)] || model[other].dec_level == 0)
+		    continue;
+		  if (model[other].dec_level < level)
+		    {
+		      shrinkable = 0;
+		      break;
+		    }
+		  mark_seen(other);
+		  open++;
+		}
+	      if (!shrinkable)
+		break;
+	    }
+
+	  if (shrinkable)
+	    {
+	      kept = 1;
+	      for (which_lit = 1; which_lit < width; which_lit++)
+		if (model[learned_lits[which_lit]].dec_level != level)
+		  learned_lits[kept++] = learned_lits[which_lit];
+	      learned_lits[kept++] = get_comp_lit(lit);
+	      itp_learned = level_itp;
+	      num_shrunk_levels++;
+	      num_shrunk_lits += width - kept;
+	      width = kept;
+	    }
+	}
+
+      // move on to the next lower level
+      while (temp_tail > trail.sequence && (*(temp_tail - 1))->dec_level == level)
+	temp_tail--;
+    }
+
+  // reset the counts, every counted level has a literal left in the clause
+  for (which_lit = 1; which_lit < width; which_lit++)
+    level_counts[model[learned_lits[which_lit]].dec_level] = 0;
+  return width;
+}
+
+var_set_size_t minimize_binary(var_set_size_t width)
+{
+  // removes every literal l from the learned clause for which there is a
+  // binary clause (u -l), where u is the negated UIP: resolving with it drops l.
+  // the literals of the clause are stamped, so each binary clause watched by u
+  // is checked in constant time. the binary clauses implied by at-most-one
+  // constraints containing -u are used in the same way. returns the new width
+  mutable_t* watches = &(model[get_comp_lit(learned_lits[0])].watched_lits);
+  mutable_size_t which_clause;
+  var_set_size_t which_lit, kept;
+  lit_t other;
+  cls_t cls;
+
+  for (which_lit = 1; which_lit < width; which_lit++)
+    bin_stamps[learned_lits[which_lit]] = num_conflicts;
+
+  // the stamp of a literal to be removed is cleared
+  for (which_clause = 0; which_clause < watches->used; which_clause++)
+    {
+      cls = watches->data[which_clause];
+      if (cls[0] != 2)
+	continue;
+      other = get_comp_lit((cls[1] == learned_lits[0]) ? cls[2] : cls[1]);
+      if (bin_stamps[other] == num_conflicts)
+	{
+	  bin_stamps[other] = 0;
+	  if (itp_filename != NULL)
+	    itp_learned = itp_resolve(itp_learned, *cls_itp(cls), get_var(other));
+	}
+    }
+  if (amo_watches != NULL)
+    {
+      watches = amo_watches + get_comp_lit(learned_lits[0]);
+      for (which_clause = 0; which_clause < watches->used; which_clause++)
+	{
+	  cls = watches->data[which_clause];
+	  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	    if (bin_stamps[cls[which_lit]] == num_conflicts)
+	      bin_stamps[cls[which_lit]] = 0;
+	}
+    }
+
+  kept = 1;
+  for (which_lit = 1; which_lit < width; which_lit++)
+    if (bin_stamps[learned_lits[which_lit]] == num_conflicts)
+      learned_lits[kept++] = learned_lits[which_lit];
+  num_bin_minimized_lits += width - kept;
+  return kept;
+}
+
+// DECISION RELATED FUNCTIONS
+
+void jw_add_clause(lit_t* lits, var_set_size_t width)
+{
+  // each literal of a clause of width w scores 2^-w
+  double weight;
+  var_set_size_t which_lit;
+
+  weight = width < sizeof(unsigned long) * 8 ? 1.0 / (1UL << width) : 0.0;
+  for (which_lit = 0; which_lit < width; which_lit++)
+    jw_scores[lits[which_lit]] += weight;
+}
+
+int compare_scores(const void* var, const void* other_var)
+{
+  // orders variables by decreasing score of both their literals
+  double score, other_score;
+
+  score = jw_scores[*(lit_t*)var] + jw_scores[get_comp_lit(*(lit_t*)var)];
+  other_score = jw_scores[*(lit_t*)other_var] +
+    jw_scores[get_comp_lit(*(lit_t*)other_var)];
+  return (score < other_score) - (score > other_score);
+}
+
+void order_init()
+{
+  // sorts the decision order by score and picks the phase of each variable
+  // as the polarity with the larger score, preferring positive on ties
+  lit_t var;
+
+  for (var = 0; var < num_vars; var++)
+    {
+      var_order[var] = var;
+      phases[var] = jw_scores[var] >= jw_scores[get_comp_lit(var)] ?
+	POSITIVE : NEGATIVE;
+    }
+  qsort(var_order, num_vars, sizeof(lit_t), compare_scores);
+  mem_free(jw_scores);
+  jw_scores = NULL;
+}
+
+// CONFIGURATION RELATED FUNCTIONS
+
+// the features are scaled to about [0, 1], so that the selection model can use
+// plain euclidean distance. all are linear in the size of the formula, apart
+// from the probes, which are bounded by PROBE_LIMIT propagations
+
+void extract_features()
+{
+  // clause width histogram, variable degree statistics and literal balance
+  // from the stored clauses, then the level 0 units, and the literals implied
+  // by probing the first variables of the decision order
+  unsigned long* degrees;
+  unsigned long widths[4] = {0, 0, 0, 0};
+  unsigned long num_lits = 0, num_positive = 0, max_degree = 0;
+  unsigned long num_probes = 0, num_implied = 0, num_failed = 0;
+  double mean_degree, variance = 0;
+  cnf_size_t which_clause;
+  var_set_size_t which_lit;
+  lit_t var, lit;
+  ass_t** tail;
+  cls_t cls;
+
+  if ((degrees = (unsigned long*)mem_calloc(MEM_PREPROCESSING, num_vars + 1, sizeof(unsigned long))) == NULL)
+    error("cannot allocate features");
+  for (which_clause = 0; which_clause < cnf.size; which_clause++)
+    {
+      cls = cnf.clauses[which_clause];
+      widths[cls[0] == 2 ? 0 : cls[0] == 3 ? 1 : cls[0] < 8 ? 2 : 3]++;
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	{
+	  degrees[get_var(cls[which_lit])]++;
+	  num_positive += cls[which_lit] < num_vars;
+	}
+      num_lits += cls[0];
+    }
+  mean_degree = num_vars > 0 ? (double)num_lits / num_vars : 0;
+  for (var = 0; var < num_vars; var++)
+    {
+      variance += (degrees[var] - mean_degree) * (degrees[var] - mean_degree);
+      if (degrees[var] > max_degree)
+	max_degree = degrees[var];
+    }
+  mem_free(degrees);
+  if (num_vars > 0)
+    variance /= num_vars;
+
+  features[0] = log10(1.0 + num_vars) / 7;
+  features[1] = log10(1.0 + cnf.size) / 7;
+  features[2] = log2(1.0 + (num_vars > 0 ? (double)cnf.size / num_vars : 0)) / 3;
+  for (which_lit = 0; which_lit < 4; which_lit++)
+    features[3 + which_lit] = cnf.size > 0 ? (double)widths[which_lit] / cnf.size : 0;
+  features[7] = mean_degree > 0 ? fmin(sqrt(variance) / mean_degree, 4) / 4 : 0;
+  features[8] = mean_degree > 0 ? log2(1.0 + max_degree / mean_degree) / 10 : 0;
+  features[9] = num_lits > 0 ? (double)num_positive / num_lits : 0.5;
+
+  // the input units are propagated here already, so that the probes start
+  // from level 0. a conflict is left for preprocessing to report
+  if (unsat_found || CDCL_prop() == CONFLICT)
+    {
+      unsat_found = 1;
+      return;
+    }
+  features[10] = num_vars > 0 ? (double)(trail.tail - trail.sequence) / num_vars : 0;
+  for (var = 0; var < num_vars && num_probes < PROBE_LIMIT; var++)
+    {
+      lit = var_order[var];
+      if (lit_value(lit) != UNASSIGNED)
+	continue;
+      num_probes++;
+      tail = trail.tail;
+      dec_level++;
+      trail_add_lit(phases[lit] == POSITIVE ? lit : get_comp_lit(lit), DEC_ASS, NULL);
+      if (CDCL_prop() == CONFLICT)
+	num_failed++;
+      num_implied += trail.tail - tail - 1;
+      backtrack(0);
+    }
+  features[11] = num_probes > 0 ? log2(1.0 + (double)num_implied / num_probes) / 10 : 0;
+  features[12] = num_probes > 0 ? (double)num_failed / num_probes : 0;
+}
+
+int read_configs(char* filename, config_t* configs, double centroids[][NUM_FEATURES])
+{
+  // reads a selection model, one centroid per line:
+  //   <name> <jw|input> <jw|false|true> <restart-unit> <amos> <sweep> <autarky>
+  //   <eliminate> <feature> ... <feature>
+  // lines starting with `#' are comments. returns the number read
+  FILE* input;
+  char line[1024], order[8], phase[8];
+  int num_configs = 0, which_feature, offset, length;
+  int amos, sweep, autarky, eliminate;
+  config_t* config;
+
+  if ((input = fopen(filename, "r")) == NULL)
+    error("cannot open selection model");
+  while (num_configs < MAX_CONFIGS && fgets(line, sizeof(line), input) != NULL)
+    {
+      if (line[0] == '#' || line[0] == '\n')
+	continue;
+      config = configs + num_configs;
+      if (sscanf(line, "%31s %7s %7s %lu %d %d %d %d%n", config->name, order, phase,
+		 &config->restart_unit, &amos, &sweep, &autarky, &eliminate,
+		 &offset) != 8)
+	error("bad selection model - configuration missing");
+      config->jw_order = strcmp(order, "jw") == 0;
+      config->phase = strcmp(phase, "false") == 0 ? NEGATIVE :
+	strcmp(phase, "true") == 0 ? POSITIVE : UNASSIGNED;
+      config->amos = amos;
+      config->sweep = sweep;
+      config->autarky = autarky;
+      config->eliminate = eliminate;
+      for (which_feature = 0; which_feature < NUM_FEATURES; which_feature++)
+	{
+	  if (sscanf(line + offset, "%lf%n", centroids[num_configs] + which_feature,
+		     &length) != 1)
+	    error("bad selection model - feature missing");
+	  offset += length;
+	}
+      num_configs++;
+    }
+  fclose(input);
+  if (num_configs == 0)
+    error("bad selection model - no centroids");
+  return num_configs;
+}
+
+void apply_config()
+{
+  // sets the decision order, phases and restarts of the configuration. the
+  // preprocessing passes are checked by CDCL_preprocess
+  lit_t var;
+
+  if (!config.jw_order)
+    for (var = 0; var < num_vars; var++)
+      var_order[var] = var;
+  if (config.phase != UNASSIGNED)
+    for (var = 0; var < num_vars; var++)
+      phases[var] = config.phase;
+  restart_unit = config.restart_unit;
+  restart_limit = config.restart_unit;
+}
+
+// LUCKY PHASE RELATED FUNCTIONS
+
+truth_value_t lucky_value(lit_t lit, truth_value_t polarity)
+{
+  // the value of a literal when every unassigned variable takes the polarity
+  if (lit_value(lit) != UNASSIGNED)
+    return lit_value(lit);
+  return (lit < num_vars) == (polarity == POSITIVE) ? POSITIVE : NEGATIVE;
+}
+
+char lucky_constant(truth_value_t polarity)
+{
+  // checks whether setting every unassigned variable to the polarity satisfies
+  // the formula, and makes the assignment if so
+  cnf_size_t which_clause;
+  mutable_size_t which_amo;
+  var_set_size_t which_lit, num_true;
+  cls_t cls;
+  lit_t var;
+
+  for (which_clause = 0; which_clause < cnf.size; which_clause++)
+    {
+      cls = cnf.clauses[which_clause];
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	if (lucky_value(cls[which_lit], polarity) == POSITIVE)
+	  break;
+      if (which_lit > cls[0])
+	return 0;
+    }
+  for (which_amo = 0; which_amo < amo_constraints.used; which_amo++)
+    {
+      cls = amo_constraints.data[which_amo];
+      num_true = 0;
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	if (lucky_value(cls[which_lit], polarity) == POSITIVE)
+	  num_true++;
+      if (num_true > 1)
+	return 0;
+    }
+
+  // all checks passed, so decide the remaining variables on one level
+  dec_level++;
+  for (var = 0; var < num_vars; var++)
+    if (lit_value(var) == UNASSIGNED && !eliminated[var])
+      trail_add_lit(polarity == POSITIVE ? var : get_comp_lit(var), DEC_ASS,
+		    NULL);
+  trail.head = trail.tail;
+  return 1;
+}
+
+char lucky_greedy(truth_value_t polarity, char backward, clock_t deadline)
+{
+  // decides the unassigned variables with the polarity, in index order or in
+  // reverse, and propagates after each decision. gives up on the first
+  // conflict or when the deadline passes, backtracking to level 0
+  var_set_size_t which_var;
+  lit_t var;
+  unsigned long num_tried;
+
+  num_tried = 0;
+  for (which_var = 0; which_var < num_vars; which_var++)
+    {
+      var = backward ? num_vars - 1 - which_var : which_var;
+      if (lit_value(var) != UNASSIGNED || eliminated[var])
+	continue;
+      if (++num_tried % LUCKY_CHECK_INTERVAL == 0 && clock() > deadline)
+	{
+	  backtrack(0);
+	  return 0;
+	}
+      dec_level++;
+      trail_add_lit(polarity == POSITIVE ? var : get_comp_lit(var), DEC_ASS,
+		    NULL);
+      if (CDCL_prop() == CONFLICT)
+	{
+	  backtrack(0);
+	  return 0;
+	}
+    }
+  return 1;
+}
+
+// BIT-SLICED SEARCH RELATED FUNCTIONS
+
+// a search for small formulas that runs SLICE_WORDS * 64 random descents at
+// once: every round decides the first variable in the decision order that is
+// open in some lane, with a random polarity per lane, and propagates the
+// clauses and at-most-one constraints with bitwise operations over all lanes.
+// a lane that runs into a conflict restarts from level 0. when every lane
+// starts a round from level 0, they all decide the same variable, and if every
+// lane then conflicts with both of its values tried, no lane can get further.
+// the search also gives up once the lanes have restarted SLICE_MAX_RESTARTS
+// times on average, as descents that keep conflicting are unlikely to satisfy
+// the formula
+
+slice_word_t slice_true(lit_t lit, int word)
+{
+  // the lanes in which the literal is true
+  return lit < num_vars ? slice_pos[lit * SLICE_WORDS + word] :
+    slice_neg[(lit - num_vars) * SLICE_WORDS + word];
+}
+
+slice_word_t slice_false(lit_t lit, int word)
+{
+  // the lanes in which the literal is false
+  return lit < num_vars ? slice_neg[lit * SLICE_WORDS + word] :
+    slice_pos[(lit - num_vars) * SLICE_WORDS + word];
+}
+
+void slice_assign(lit_t lit, int word, slice_word_t lanes)
+{
+  // makes the literal true in the lanes
+  if (lit < num_vars)
+    slice_pos[lit * SLICE_WORDS + word] |= lanes;
+  else
+    slice_neg[(lit - num_vars) * SLICE_WORDS + word] |= lanes;
+}
+
+char slice_prop_word(int word, slice_word_t* conflicts)
+{
+  // one pass over the clauses and at-most-one constraints for the lanes of a
+  // word, skipping the lanes already in conflict. returns 1 if some lane
+  // assigned a literal
+  cnf_size_t which_clause;
+  mutable_size_t which_amo;
+  var_set_size_t which_lit;
+  slice_word_t satisfied, one_open, two_open, open, units;
+  slice_word_t one_true, two_true;
+  char changed = 0;
+  cls_t cls;
+
+  for (which_clause = 0; which_clause < cnf.size; which_clause++)
+    {
+      cls = cnf.clauses[which_clause];
+      satisfied = *conflicts;
+      one_open = two_open = 0;
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	{
+	  satisfied |= slice_true(cls[which_lit], word);
+	  open = ~(slice_true(cls[which_lit], word) | slice_false(cls[which_lit], word));
+	  two_open |= one_open & open;
+	  one_open |= open;
+	}
+      *conflicts |= ~satisfied & ~one_open;
+      units = ~satisfied & one_open & ~two_open;
+      if (units == 0)
+	continue;
+      changed = 1;
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	slice_assign(cls[which_lit], word,
+		     units & ~slice_false(cls[which_lit], word));
+    }
+
+  // a true literal in an at-most-one constraint makes the others false
+  for (which_amo = 0; which_amo < amo_constraints.used; which_amo++)
+    {
+      cls = amo_constraints.data[which_amo];
+      one_true = two_true = 0;
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	{
+	  two_true |= one_true & slice_true(cls[which_lit], word);
+	  one_true |= slice_true(cls[which_lit], word);
+	}
+      *conflicts |= two_true;
+      one_true &= ~*conflicts;
+      if (one_true == 0)
+	continue;
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	{
+	  units = one_true & ~slice_true(cls[which_lit], word) &
+	    ~slice_false(cls[which_lit], word);
+	  if (units == 0)
+	    continue;
+	  changed = 1;
+	  slice_assign(get_comp_lit(cls[which_lit]), word, units);
+	}
+    }
+  return changed;
+}
+
+uint64_t slice_random()
+{
+  // xorshift64
+  slice_seed ^= slice_seed << 13;
+  slice_seed ^= slice_seed >> 7;
+  slice_seed ^= slice_seed << 17;
+  return slice_seed;
+}
+
+// LOCAL SEARCH RELATED FUNCTIONS
+
+// a ProbSAT walker picks a random falsified clause and flips one of its
+// variables, chosen with probability proportional to (1 + break)^-cb, where
+// the break count is the number of clauses that would become falsified.
+// every walker runs in its own thread with its own cb
+
+void walk_arena_add(lit_t* lits, var_set_size_t width, cnf_size_t* num_lits)
+{
+  // appends a clause to the arena, or only counts its literals while the
+  // arena is not allocated
+  var_set_size_t which_lit;
+
+  if (walk_lits != NULL)
+    {
+      walk_starts[walk_num_clauses] = *num_lits;
+      walk_lits[*num_lits] = width;
+      for (which_lit = 0; which_lit < width; which_lit++)
+	{
+	  walk_lits[*num_lits + 1 + which_lit] = lits[which_lit];
+	  walk_occ_starts[lits[which_lit]]++;
+	}
+    }
+  walk_num_clauses++;
+  *num_lits += width + 1;
+}
+
+void walk_arena_init()
+{
+  // builds the arena from the cnf and the at-most-one constraints in two
+  // passes, the first of which only counts
+  cnf_size_t which_clause, num_lits, which_occ;
+  mutable_size_t which_amo;
+  var_set_size_t which_lit, other_lit, width;
+  model_size_t which_ass;
+  lit_t lits[2];
+  lit_t* kept;
+  cls_t cls;
+  char pass;
+
+  if ((kept = (lit_t*)mem_alloc(MEM_SEARCH, sizeof(lit_t) * (num_vars + 1))) == NULL ||
+      (walk_occ_starts = (cnf_size_t*)mem_calloc(MEM_SEARCH, num_asses + 1, sizeof(cnf_size_t))) == NULL)
+    error("cannot allocate local search");
+  walk_lits = NULL;
+  for (pass = 0; pass < 2; pass++)
+    {
+      walk_num_clauses = 0;
+      num_lits = 0;
+      for (which_clause = 0; which_clause < cnf.size; which_clause++)
+	{
+	  cls = cnf.clauses[which_clause];
+	  if (cls_is_satisfied(cls))
+	    continue;
+	  width = 0;
+	  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	    if (lit_value(cls[which_lit]) == UNASSIGNED)
+	      kept[width++] = cls[which_lit];
+	  walk_arena_add(kept, width, &num_lits);
+	}
+      for (which_amo = 0; which_amo < amo_constraints.used; which_amo++)
+	{
+	  cls = amo_constraints.data[which_amo];
+	  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	    for (other_lit = which_lit + 1; other_lit <= cls[0]; other_lit++)
+	      {
+		if (lit_value(cls[which_lit]) != UNASSIGNED ||
+		    lit_value(cls[other_lit]) != UNASSIGNED)
+		  continue;
+		lits[0] = get_comp_lit(cls[which_lit]);
+		lits[1] = get_comp_lit(cls[other_lit]);
+		walk_arena_add(lits, 2, &num_lits);
+	      }
+	}
+      if (pass == 1)
+	break;
+      if ((walk_lits = (lit_t*)mem_alloc(MEM_SEARCH, sizeof(lit_t) * (num_lits + 1))) == NULL ||
+	  (walk_starts = (cnf_size_t*)mem_alloc(MEM_SEARCH, sizeof(cnf_size_t) *
+					     (walk_num_clauses + 1))) == NULL)
+	error("cannot allocate local search");
+    }
+
+  // turn the occurrence counts into the ends of the lists, then fill the lists
+  // backwards so that the counts become their starts
+  for (which_ass = 1; which_ass <= num_asses; which_ass++)
+    walk_occ_starts[which_ass] += walk_occ_starts[which_ass - 1];
+  if ((walk_occs = (cnf_size_t*)mem_alloc(MEM_SEARCH, sizeof(cnf_size_t) *
+				       (walk_occ_starts[num_asses] + 1))) == NULL)
+    error("cannot allocate local search");
+  for (which_clause = 0; which_clause < walk_num_clauses; which_clause++)
+    for (which_lit = 1; which_lit <= walk_lits[walk_starts[which_clause]]; which_lit++)
+      {
+	which_occ = --walk_occ_starts[walk_lits[walk_starts[which_clause] + which_lit]];
+	walk_occs[which_occ] = which_clause;
+      }
+  mem_free(kept);
+}
+
+void walk_arena_free()
+{
+  mem_free(walk_lits);
+  mem_free(walk_starts);
+  mem_free(walk_occ_starts);
+  mem_free(walk_occs);
+}
+
+uint64_t walk_random(walker_t* walker)
+{
+  // xorshift64
+  walker->seed ^= walker->seed << 13;
+  walker->seed ^= walker->seed >> 7;
+  walker->seed ^= walker->seed << 17;
+  return walker->seed;
+}
+
+char walk_lit_true(walker_t* walker, lit_t lit)
+{
+  return lit < num_vars ? walker->values[lit] : !walker->values[lit - num_vars];
+}
+
+void walk_make_unsat(walker_t* walker, cnf_size_t which_clause)
+{
+  walker->unsat_positions[which_clause] = walker->num_unsat;
+  walker->unsat[walker->num_unsat++] = which_clause;
+}
+
+void walk_make_sat(walker_t* walker, cnf_size_t which_clause)
+{
+  cnf_size_t last = walker->unsat[--walker->num_unsat];
+
+  walker->unsat[walker->unsat_positions[which_clause]] = last;
+  walker->unsat_positions[last] = walker->unsat_positions[which_clause];
+}
+
+void walk_flip(walker_t* walker, lit_t var)
+{
+  // flips the variable and updates the counts of the clauses it occurs in
+  lit_t true_lit, false_lit;
+  cnf_size_t which_occ, which_clause;
+
+  walker->values[var] = !walker->values[var];
+  true_lit = walker->values[var] ? var : get_comp_lit(var);
+  false_lit = get_comp_lit(true_lit);
+  for (which_occ = walk_occ_starts[true_lit];
+       which_occ < walk_occ_starts[true_lit + 1]; which_occ++)
+    {
+      which_clause = walk_occs[which_occ];
+      if (++walker->true_counts[which_clause] == 1)
+	{
+	  walk_make_sat(walker, which_clause);
+	  walker->breaks[var]++;
+	}
+      else if (walker->true_counts[which_clause] == 2)
+	walker->breaks[walker->true_xors[which_clause]]--;
+      walker->true_xors[which_clause] ^= var;
+    }
+  for (which_occ = walk_occ_starts[false_lit];
+       which_occ < walk_occ_starts[false_lit + 1]; which_occ++)
+    {
+      which_clause = walk_occs[which_occ];
+      walker->true_xors[which_clause] ^= var;
+      if (--walker->true_counts[which_clause] == 0)
+	{
+	  walk_make_unsat(walker, which_clause);
+	  walker->breaks[var]--;
+	}
+      else if (walker->true_counts[which_clause] == 1)
+	walker->breaks[walker->true_xors[which_clause]]++;
+    }
+  walker->flips++;
+}
+
+void walker_init(walker_t* walker, int index, int num_walkers)
+{
+  // allocates the walker and starts it from the preferred phases, or from a
+  // random assignment for all but the first walker
+  var_set_size_t which_lit, width;
+  cnf_size_t which_clause;
+  lit_t var, lit;
+  double cb;
+  int which_break;
+
+  walker->seed = 0x9e3779b97f4a7c15ULL * (index + 1);
+  walker->flips = 0;
+  walker->num_unsat = 0;
+  cb = 2.0 + 2.0 * index / num_walkers;
+  for (which_break = 0; which_break <= WALK_BREAK_MAX; which_break++)
+    walker->probs[which_break] = pow(1.0 + which_break, -cb);
+  if ((walker->values = (char*)mem_alloc(MEM_SEARCH, sizeof(char) * num_vars)) == NULL ||
+      (walker->breaks = (var_set_size_t*)mem_calloc(MEM_SEARCH, num_vars, sizeof(var_set_size_t))) == NULL ||
+      (walker->true_counts = (var_set_size_t*)mem_calloc(MEM_SEARCH, walk_num_clauses + 1,
+						     sizeof(var_set_size_t))) == NULL ||
+      (walker->true_xors = (lit_t*)mem_calloc(MEM_SEARCH, walk_num_clauses + 1, sizeof(lit_t))) == NULL ||
+      (walker->unsat = (cnf_size_t*)mem_alloc(MEM_SEARCH, sizeof(cnf_size_t) *
+					   (walk_num_clauses + 1))) == NULL ||
+      (walker->unsat_positions = (cnf_size_t*)mem_alloc(MEM_SEARCH, sizeof(cnf_size_t) *
+						     (walk_num_clauses + 1))) == NULL)
+    error("cannot allocate walker");
+
+  for (var = 0; var < num_vars; var++)
+    walker->values[var] = index == 0 ? phases[var] == POSITIVE :
+      (char)(walk_random(walker) & 1);
+  for (which_clause = 0; which_clause < walk_num_clauses; which_clause++)
+    {
+      width = walk_lits[walk_starts[which_clause]];
+      for (which_lit = 1; which_lit <= width; which_lit++)
+	{
+	  lit = walk_lits[walk_starts[which_clause] + which_lit];
+	  if (!walk_lit_true(walker, lit))
+	    continue;
+	  walker->true_counts[which_clause]++;
+	  walker->true_xors[which_clause] ^= get_var(lit);
+	}
+      if (walker->true_counts[which_clause] == 0)
+	walk_make_unsat(walker, which_clause);
+      else if (walker->true_counts[which_clause] == 1)
+	walker->breaks[walker->true_xors[which_clause]]++;
+    }
+}
+
+void walker_free(walker_t* walker)
+{
+  mem_free(walker->values);
+  mem_free(walker->breaks);
+  mem_free(walker->true_counts);
+  mem_free(walker->true_xors);
+  mem_free(walker->unsat);
+  mem_free(walker->unsat_positions);
+}
+
+double walk_prob(walker_t* walker, lit_t var)
+{
+  // the unnormalised probability of flipping the variable
+  return walker->probs[walker->breaks[var] < WALK_BREAK_MAX ?
+		       walker->breaks[var] : WALK_BREAK_MAX];
+}
+
+void* walker_run(void* argument)
+{
+  // flips until the walker satisfies every clause, another walker has won, or
+  // the deadline has passed
+  walker_t* walker = (walker_t*)argument;
+  double sum, pick;
+  var_set_size_t which_lit, width;
+  lit_t* cls;
+  char stop;
+
+  while (walker->num_unsat > 0)
+    {
+      if (walker->flips % WALK_CHECK_INTERVAL == 0)
+	{
+	  pthread_mutex_lock(&walk_mutex);
+	  stop = walk_winner != NULL || time(NULL) >= walk_deadline;
+	  pthread_mutex_unlock(&walk_mutex);
+	  if (stop)
+	    return NULL;
+	}
+
+      // pick a falsified clause, then a variable of it by its break count
+      cls = walk_lits + walk_starts[walker->unsat[walk_random(walker) % walker->num_unsat]];
+      width = cls[0];
+      sum = 0;
+      for (which_lit = 1; which_lit <= width; which_lit++)
+	sum += walk_prob(walker, get_var(cls[which_lit]));
+      pick = (walk_random(walker) >> 11) * (1.0 / 9007199254740992.0) * sum;
+      for (which_lit = 1; which_lit < width; which_lit++)
+	{
+	  pick -= walk_prob(walker, get_var(cls[which_lit]));
+	  if (pick < 0)
+	    break;
+	}
+      walk_flip(walker, get_var(cls[which_lit]));
+    }
+
+  pthread_mutex_lock(&walk_mutex);
+  if (walk_winner == NULL)
+    walk_winner = walker;
+  pthread_mutex_unlock(&walk_mutex);
+  return NULL;
+}
+
+// PORTFOLIO RELATED FUNCTIONS
+
+void arena_init()
+{
+  // moves the clauses of the formula into the arena, with the same watches
+  cnf_size_t which_clause, size = 0;
+  var_set_size_t which_lit;
+  ass_t** temp_pointer;
+  lit_t* cursor;
+  cls_t cls;
+
+  for (which_clause = 0; which_clause < cnf.size; which_clause++)
+    size += cnf.clauses[which_clause][0] + 2;
+  if ((arena = (lit_t*)mem_alloc(MEM_CLAUSES, sizeof(lit_t) * (size + 1))) == NULL ||
+      (watch_pairs = (lit_t*)mem_alloc(MEM_WATCHES, sizeof(lit_t) * 2 * (cnf.size + 1))) == NULL)
+    error("cannot allocate clause arena");
+  cursor = arena;
+  for (which_clause = 0; which_clause < cnf.size; which_clause++)
+    {
+      cls = cnf.clauses[which_clause];
+      *(cursor++) = which_clause;
+      for (which_lit = 0; which_lit <= cls[0]; which_lit++)
+	cursor[which_lit] = cls[which_lit];
+      watch_pairs[2 * which_clause] = cls[1];
+      watch_pairs[2 * which_clause + 1] = cls[2];
+      cnf.clauses[which_clause] = cursor;
+      cursor += cls[0] + 1;
+      cls_free(cls);
+    }
+  arena_end = cursor;
+
+  // the search does not use the reasons of level 0, some of which were the
+  // old clauses
+  for (temp_pointer = trail.sequence; temp_pointer < trail.tail; temp_pointer++)
+    if ((*temp_pointer)->dec_level == 0 && (*temp_pointer)->ass_type != AMO_ASS)
+      {
+	model[*temp_pointer - model].reason = NULL;
+	model[get_comp_lit(*temp_pointer - model)].reason = NULL;
+      }
+
+  // the watch lists still hold the old clauses
+  for (which_clause = 0; which_clause < (cnf_size_t)num_asses; which_clause++)
+    model[which_clause].watched_lits.used = 0;
+  for (which_clause = 0; which_clause < cnf.size; which_clause++)
+    {
+      cls = cnf.clauses[which_clause];
+      mutable_push(&(model[get_comp_lit(watch_pairs[2 * which_clause])].watched_lits), cls);
+      mutable_push(&(model[get_comp_lit(watch_pairs[2 * which_clause + 1])].watched_lits), cls);
+    }
+  for (which_clause = 0; which_clause < learned_cnf.used; which_clause++)
+    {
+      cls = learned_cnf.data[which_clause];
+      mutable_push(&(model[get_comp_lit(cls[1])].watched_lits), cls);
+      mutable_push(&(model[get_comp_lit(cls[2])].watched_lits), cls);
+    }
+}
+
+void exchange_export(var_set_size_t width)
+{
+  // shares the learned clause in learned_lits if it is short enough
+  exchange_slot_t* slot;
+  unsigned long ticket, seq;
+  var_set_size_t which_lit;
+
+  if (exchange == NULL || width > EXCHANGE_MAX_WIDTH)
+    return;
+  ticket = __atomic_fetch_add(&exchange->head, 1, __ATOMIC_RELAXED);
+  slot = exchange->slots + ticket % EXCHANGE_SLOTS;
+  // a stalled writer must not write into a slot another writer holds or has
+  // published for a later ticket
+  seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+  if ((seq & 1) || seq > 2 * ticket ||
+      !__atomic_compare_exchange_n(&slot->seq, &seq, 2 * ticket + 1, 0,
+				   __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    return;
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  __atomic_store_n(&slot->worker, worker_index, __ATOMIC_RELAXED);
+  __atomic_store_n(&slot->width, width, __ATOMIC_RELAXED);
+  for (which_lit = 0; which_lit < width; which_lit++)
+    __atomic_store_n(slot->lits + which_lit, learned_lits[which_lit], __ATOMIC_RELAXED);
+  __atomic_store_n(&slot->seq, 2 * ticket + 2, __ATOMIC_RELEASE);
+  num_exported++;
+}
+
+void exchange_add(lit_t* lits, var_set_size_t width)
+{
+  // adds an imported clause at level 0, without the literals false there
+  var_set_size_t which_lit, kept = 0;
+  cls_t cls;
+
+  for (which_lit = 0; which_lit < width; which_lit++)
+    {
+      if (lit_value(lits[which_lit]) == POSITIVE)
+	return;
+      if (lit_value(lits[which_lit]) == UNASSIGNED)
+	lits[kept++] = lits[which_lit];
+    }
+  num_imported++;
+  if (kept == 0)
+    CDCL_report_UNSAT();
+  if (kept == 1)
+    {
+      trail_add_lit(lits[0], PROP_ASS, NULL);
+      return;
+    }
+  cls = cls_init(kept, MEM_LEARNED);
+  for (which_lit = 0; which_lit < kept; which_lit++)
+    cls[which_lit + 1] = lits[which_lit];
+  mutable_push(&(model[get_comp_lit(cls[1])].watched_lits), cls);
+  mutable_push(&(model[get_comp_lit(cls[2])].watched_lits), cls);
+  mutable_push(&learned_cnf, cls);
+}
+
+void exchange_import()
+{
+  // adds the clauses the other workers shared since the last import. slots
+  // overwritten before they were read are lost
+  exchange_slot_t* slot;
+  unsigned long head, seq;
+  lit_t lits[EXCHANGE_MAX_WIDTH];
+  var_set_size_t which_lit, width;
+  int worker;
+
+  head = __atomic_load_n(&exchange->head, __ATOMIC_RELAXED);
+  if (head - exchange_cursor > EXCHANGE_SLOTS)
+    exchange_cursor = head - EXCHANGE_SLOTS;
+  for (; exchange_cursor < head; exchange_cursor++)
+    {
+      slot = exchange->slots + exchange_cursor % EXCHANGE_SLOTS;
+      seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+      if (seq != 2 * exchange_cursor + 2)
+	continue;
+      worker = __atomic_load_n(&slot->worker, __ATOMIC_RELAXED);
+      width = __atomic_load_n(&slot->width, __ATOMIC_RELAXED);
+      if (width > EXCHANGE_MAX_WIDTH)
+	continue;
+      for (which_lit = 0; which_lit < width; which_lit++)
+	lits[which_lit] = __atomic_load_n(slot->lits + which_lit, __ATOMIC_RELAXED);
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != seq ||
+	  worker == worker_index)
+	continue;
+      exchange_add(lits, width);
+    }
+}
+
+unsigned long luby(unsigned long i)
+{
+  // the i-th element, counting from 0, of 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8 ...
+  unsigned long size = 1, power = 0;
+
+  while (size < i + 1)
+    {
+      power++;
+      size = 2 * size + 1;
+    }
+  while (size - 1 != i)
+    {
+      size = (size - 1) / 2;
+      power--;
+      i = i % size;
+    }
+  return 1UL << power;
+}
+
+void restart_if_due()
+{
+  // restarts on the luby schedule, and imports the shared clauses at level 0.
+  // a worker whose parent has gone stops here
+  if (restart_unit == 0 || ++conflicts_since_restart < restart_limit)
+    return;
+  if (exchange != NULL && getppid() != portfolio_parent)
+    _exit(1);
+  backtrack(0);
+  num_restarts++;
+  conflicts_since_restart = 0;
+  restart_limit = restart_unit * luby(num_restarts);
+  if (exchange != NULL)
+    exchange_import();
+}
+
+char exchange_claim()
+{
+  // returns 1 if this process may report its result, which in a portfolio
+  // only the first worker to finish may
+  int none = 0;
+
+  return exchange == NULL ||
+    __atomic_compare_exchange_n(&exchange->winner, &none, worker_index + 1, 0,
+				__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+// MINI SOLVER RELATED FUNCTIONS
+
+// a small DPLL solver for at most MINI_MAX variables and clauses, used on
+// the few clauses around a variable. clauses and assignments are bitsets over
+// local variables, so the solver allocates nothing and never touches the
+// model, the trail or the watched literals
+
+void mini_reset()
+{
+  mini_num_clauses = 0;
+  mini_num_vars = 0;
+  mini_steps = 0;
+}
+
+int mini_local(lit_t var)
+{
+  // returns the local index of the variable, or -1 if it has none
+  int local;
+
+  for (local = 0; local < mini_num_vars; local++)
+    if (mini_vars[local] == var)
+      return local;
+  return -1;
+}
+
+int mini_add_clause(cls_t cls, lit_t skip_var)
+{
+  // adds the clause without the literals of skip_var and those false at
+  // level 0, and returns its index. returns -1 if the clause is satisfied at
+  // level 0, and -2 if the solver is full
+  var_set_size_t which_lit;
+  lit_t lit;
+  int local;
+
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    if (lit_value(cls[which_lit]) == POSITIVE)
+      return -1;
+  if (mini_num_clauses == MINI_MAX)
+    return -2;
+  mini_pos[mini_num_clauses] = 0;
+  mini_neg[mini_num_clauses] = 0;
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    {
+      lit = cls[which_lit];
+      if (get_var(lit) == skip_var || lit_value(lit) == NEGATIVE)
+	continue;
+      local = mini_local(get_var(lit));
+      if (local == -1)
+	{
+	  if (mini_num_vars == MINI_MAX)
+	    return -2;
+	  local = mini_num_vars++;
+	  mini_vars[local] = get_var(lit);
+	}
+      if (lit < num_vars)
+	mini_pos[mini_num_clauses] |= (mini_set_t)1 << local;
+      else
+	mini_neg[mini_num_clauses] |= (mini_set_t)1 << local;
+    }
+  return mini_num_clauses++;
+}
+
+void mini_lemma(char deletion, mini_set_t true_vars, mini_set_t false_vars)
+{
+  // writes the clause falsified by the partial assignment to the proof, if the
+  // mini solver is proving
+  lit_t lits[MINI_MAX];
+  var_set_size_t width = 0;
+  int local;
+
+  if (!mini_proof)
+    return;
+  for (local = 0; local < mini_num_vars; local++)
+    if ((true_vars >> local) & 1)
+      lits[width++] = get_comp_lit(mini_vars[local]);
+    else if ((false_vars >> local) & 1)
+      lits[width++] = mini_vars[local];
+  proof_write(deletion, lits, width);
+}
+
+result_t mini_solve(mini_set_t active, mini_set_t true_vars, mini_set_t false_vars)
+{
+  // decides the clauses in `active' under the partial assignment, with unit
+  // propagation and branching on the first open variable. returns SAT, UNSAT,
+  // or UNKNOWN once the step limit is reached
+  mini_set_t open_pos, open_neg, branch = 0;
+  mini_set_t given_true = true_vars, given_false = false_vars;
+  result_t result;
+  char changed = 1;
+  int which_clause;
+
+  while (changed)
+    {
+      changed = 0;
+      branch = 0;
+      for (which_clause = 0; which_clause < mini_num_clauses; which_clause++)
+	{
+	  if (!((active >> which_clause) & 1) ||
+	      (mini_pos[which_clause] & true_vars) ||
+	      (mini_neg[which_clause] & false_vars))
+	    continue;
+	  if (++mini_steps > MINI_STEP_LIMIT)
+	    return UNKNOWN;
+	  open_pos = mini_pos[which_clause] & ~false_vars;
+	  open_neg = mini_neg[which_clause] & ~true_vars;
+	  if ((open_pos | open_neg) == 0)
+	    {
+	      mini_lemma(0, given_true, given_false);
+	      return UNSAT;
+	    }
+	  if (open_neg == 0 && (open_pos & (open_pos - 1)) == 0)
+	    {
+	      true_vars |= open_pos;
+	      changed = 1;
+	    }
+	  else if (open_pos == 0 && (open_neg & (open_neg - 1)) == 0)
+	    {
+	      false_vars |= open_neg;
+	      changed = 1;
+	    }
+	  else
+	    branch = open_pos | open_neg;
+	}
+    }
+  if (branch == 0)
+    return SAT;
+
+  // branch on the lowest open variable of the last open clause
+  branch &= ~(branch - 1);
+  result = mini_solve(active, true_vars | branch, false_vars);
+  if (result != UNSAT)
+    return result;
+  result = mini_solve(active, true_vars, false_vars | branch);
+  // the lemma of this call follows from those of its branches, which are no
+  // longer needed
+  if (result == UNSAT)
+    {
+      mini_lemma(0, given_true, given_false);
+      mini_lemma(1, true_vars, false_vars | branch);
+    }
+  mini_lemma(1, true_vars | branch, false_vars);
+  return result;
+}
+
+mini_set_t mini_core(mini_set_t active)
+{
+  // shrinks an unsatisfiable set of clauses by trying to drop each clause in
+  // turn. returns the set, or 0 if it is satisfiable or the step limit is hit
+  // before it is known to be unsatisfiable
+  mini_set_t core = active, bit;
+  int which_clause;
+
+  if (mini_solve(core, 0, 0) != UNSAT)
+    return 0;
+  for (which_clause = 0; which_clause < mini_num_clauses; which_clause++)
+    {
+      bit = (mini_set_t)1 << which_clause;
+      if (!(core & bit))
+	continue;
+      switch (mini_solve(core & ~bit, 0, 0))
+	{
+	case UNSAT:
+	  core &= ~bit;
+	  break;
+	case UNKNOWN:
+	  return core;
+	}
+    }
+  return core;
+}
+
+// PREPROCESSING RELATED FUNCTIONS
+
+// preprocessing runs once at decision level 0, after the initial propagation.
+// it works on occurrence lists instead of watched literals: the clauses are
+// gathered into pre_clauses, simplified there, and written back into the cnf
+// with fresh watches when preprocessing finishes.
+// a clause is removed by setting its width to 0; it stays in the occurrence
+// lists of its other literals until the cnf is written back
+
+// literal and clause scratch space used while eliminating a variable
+lit_t* resolvent;
+mutable_t pos_clauses;
+mutable_t neg_clauses;
+
+void pre_add_unit(lit_t lit)
+{
+  // assigns a unit clause derived during preprocessing at level 0. a false
+  // unit goes to the proof as well, before the clauses it follows from may be
+  // deleted
+  if (lit_value(lit) != POSITIVE)
+    proof_add(&lit, 1);
+  if (lit_value(lit) == NEGATIVE)
+    unsat_found = 1;
+  if (lit_value(lit) == UNASSIGNED)
+    trail_add_lit(lit, PROP_ASS, NULL);
+}
+
+void pre_add_clause(cls_t cls)
+{
+  // adds the clause to the preprocessed clauses and to its occurrence lists
+  var_set_size_t which_lit;
+
+  mutable_push(&pre_clauses, cls);
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    mutable_push(occs + cls[which_lit], cls);
+}
+
+void pre_init()
+{
+  // gathers the clauses of the cnf, removing duplicate literals, tautologies and
+  // clauses satisfied at level 0, and builds the occurrence lists
+  model_size_t which_ass;
+  cnf_size_t which_clause;
+  var_set_size_t which_lit, width;
+  char tautology;
+  lit_t lit;
+  cls_t cls;
+
+  if ((occs = (mutable_t*)mem_alloc(MEM_PREPROCESSING, sizeof(mutable_t) * num_asses)) == NULL)
+    error("cannot allocate occurrence lists");
+  for (which_ass = 0; which_ass < num_asses; which_ass++)
+    mutable_init(occs + which_ass, MEM_PREPROCESSING);
+  if ((lit_stamps = (unsigned long*)mem_calloc(MEM_PREPROCESSING, num_asses, sizeof(unsigned long))) == NULL)
+    error("cannot allocate literal stamps");
+  stamp = 0;
+  if ((resolvent = (lit_t*)mem_alloc(MEM_PREPROCESSING, sizeof(lit_t) * num_vars)) == NULL)
+    error("cannot allocate resolvent");
+  mutable_init(&pos_clauses, MEM_PREPROCESSING);
+  mutable_init(&neg_clauses, MEM_PREPROCESSING);
+  mutable_init(&pre_clauses, MEM_PREPROCESSING);
+
+  for (which_clause = 0; which_clause < cnf.size; which_clause++)
+    {
+      cls = cnf.clauses[which_clause];
+      stamp++;
+      tautology = 0;
+      width = 0;
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	{
+	  lit = cls[which_lit];
+	  if (lit_stamps[get_comp_lit(lit)] == stamp)
+	    tautology = 1;
+	  if (lit_stamps[lit] == stamp)
+	    continue;
+	  lit_stamps[lit] = stamp;
+	  cls[++width] = lit;
+	}
+      cls[0] = width;
+      // duplicate literals may leave a unit, which would be taken for a
+      // witness once on the extension stack
+      if (!tautology && width == 1)
+	pre_add_unit(cls[1]);
+      if (tautology || width == 1 || cls_is_satisfied(cls))
+	cls_free(cls);
+      else
+	pre_add_clause(cls);
+    }
+  mem_free(cnf.clauses);
+}
+
+void pre_gather(lit_t lit, mutable_t* gathered)
+{
+  // collects the remaining clauses containing lit into `gathered', removing
+  // clauses satisfied at level 0 and compacting the occurrence list on the way
+  mutable_t* occ = occs + lit;
+  mutable_size_t which_clause, kept;
+  cls_t cls;
+
+  gathered->used = 0;
+  kept = 0;
+  for (which_clause = 0; which_clause < occ->used; which_clause++)
+    {
+      cls = occ->data[which_clause];
+      if (cls[0] == 0)
+	continue;
+      if (cls_is_satisfied(cls))
+	{
+	  cls[0] = 0;
+	  continue;
+	}
+      occ->data[kept++] = cls;
+      mutable_push(gathered, cls);
+    }
+  occ->used = kept;
+}
+
+char cls_contains(cls_t cls, lit_t lit)
+{
+  // returns 1 if the clause contains the literal, 0 otherwise
+  var_set_size_t which_lit;
+
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    if (cls[which_lit] == lit)
+      return 1;
+  return 0;
+}
+
+cls_t find_ternary(mutable_t* clauses, lit_t lit, lit_t other_lit)
+{
+  // returns a ternary clause from `clauses' containing both literals, or NULL
+  mutable_size_t which_clause;
+  cls_t cls;
+
+  for (which_clause = 0; which_clause < clauses->used; which_clause++)
+    {
+      cls = clauses->data[which_clause];
+      if (cls[0] == 3 && cls_contains(cls, lit) && cls_contains(cls, other_lit))
+	return cls;
+    }
+  return NULL;
+}
+
+void mark_gate_clause(mutable_t* clauses, mutable_size_t* num_gate_clauses, cls_t cls)
+{
+  // moves the clause to the front of `clauses', behind the gate clauses
+  // already found
+  mutable_size_t which_clause;
+
+  for (which_clause = *num_gate_clauses; which_clause < clauses->used; which_clause++)
+    if (clauses->data[which_clause] == cls)
+      {
+	clauses->data[which_clause] = clauses->data[*num_gate_clauses];
+	clauses->data[(*num_gate_clauses)++] = cls;
+	return;
+      }
+}
+
+// the gate finders below look for a definition of the variable being
+// eliminated among out_clauses (the clauses containing the output literal) and
+// in_clauses (the clauses containing its complement). on success, the gate
+// clauses are moved to the front of both lists, and the gate type is counted
+// by the caller
+
+var_set_size_t find_and_gate(lit_t out, mutable_t* out_clauses, mutable_size_t* out_gates,
+		   mutable_t* in_clauses, mutable_size_t* in_gates)
+{
+  // looks for out = AND(l_1, ..., l_k), defined by the binary clauses
+  // (-out l_i) and the clause (out -l_1 ... -l_k). the case k = 1 is an
+  // equivalence. returns the gate width k, or 0 if no gate is found
+  mutable_size_t which_clause;
+  var_set_size_t which_lit;
+  lit_t comp_out = get_comp_lit(out);
+  lit_t other;
+  cls_t cls;
+
+  // stamp the literals implied by out through binary clauses
+  stamp++;
+  for (which_clause = 0; which_clause < in_clauses->used; which_clause++)
+    {
+      cls = in_clauses->data[which_clause];
+      if (cls[0] == 2)
+	lit_stamps[cls[1] == comp_out ? cls[2] : cls[1]] = stamp;
+    }
+
+  // find a clause whose other literals are all negations of stamped literals
+  for (which_clause = 0; which_clause < out_clauses->used; which_clause++)
+    {
+      cls = out_clauses->data[which_clause];
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	if (cls[which_lit] != out &&
+	    lit_stamps[get_comp_lit(cls[which_lit])] != stamp)
+	  break;
+      if (which_lit <= cls[0])
+	continue;
+
+      // found a gate: mark the long clause and one binary clause per input
+      mark_gate_clause(out_clauses, out_gates, cls);
+      stamp++;
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	lit_stamps[get_comp_lit(cls[which_lit])] = stamp;
+      for (which_clause = 0; which_clause < in_clauses->used; which_clause++)
+	{
+	  if (in_clauses->data[which_clause][0] != 2)
+	    continue;
+	  cls = in_clauses->data[which_clause];
+	  other = (cls[1] == comp_out) ? cls[2] : cls[1];
+	  if (lit_stamps[other] == stamp)
+	    {
+	      lit_stamps[other] = 0;
+	      mark_gate_clause(in_clauses, in_gates, cls);
+	    }
+	}
+      return *in_gates;
+    }
+  return 0;
+}
+
+char find_ite_gate(lit_t out, mutable_t* out_clauses, mutable_size_t* out_gates,
+		   mutable_t* in_clauses, mutable_size_t* in_gates)
+{
+  // looks for out = ITE(c, t, e), defined by the clauses (-out -c t),
+  // (-out c e), (out -c -t) and (out c -e). the case t = -e is an XOR gate.
+  // returns 1 for an ITE gate, 2 for an XOR gate, 0 if no gate is found
+  mutable_size_t which_first, which_second;
+  lit_t comp_out = get_comp_lit(out);
+  lit_t lits[2], cond, then_lit, else_lit;
+  cls_t first, second, third, fourth;
+  int role;
+
+  for (which_first = 0; which_first < in_clauses->used; which_first++)
+    {
+      first = in_clauses->data[which_first];
+      if (first[0] != 3)
+	continue;
+      lits[0] = (first[1] == comp_out) ? first[3] : first[1];
+      lits[1] = (first[2] == comp_out) ? first[3] : first[2];
+
+      // either literal of the first clause may be the negated condition
+      for (role = 0; role < 2; role++)
+	{
+	  cond = get_comp_lit(lits[role]);
+	  then_lit = lits[1 - role];
+	  for (which_second = 0; which_second < in_clauses->used; which_second++)
+	    {
+	      second = in_clauses->data[which_second];
+	      if (second[0] != 3 || second == first || !cls_contains(second, cond))
+		continue;
+	      else_lit = second[1] ^ second[2] ^ second[3] ^ comp_out ^ cond;
+	      if (get_var(else_lit) == get_var(cond) || else_lit == then_lit)
+		continue;
+	      third = find_ternary(out_clauses, lits[role], get_comp_lit(then_lit));
+	      fourth = find_ternary(out_clauses, cond, get_comp_lit(else_lit));
+	      if (third == NULL || fourth == NULL || third == fourth)
+		continue;
+
+	      mark_gate_clause(in_clauses, in_gates, first);
+	      mark_gate_clause(in_clauses, in_gates, second);
+	      mark_gate_clause(out_clauses, out_gates, third);
+	      mark_gate_clause(out_clauses, out_gates, fourth);
+	      return (then_lit == get_comp_lit(else_lit)) ? 2 : 1;
+	    }
+	}
+    }
+  return 0;
+}
+
+char find_definition(lit_t var, mutable_t* pos_clauses, mutable_size_t* pos_gates,
+		     mutable_t* neg_clauses, mutable_size_t* neg_gates)
+{
+  // looks for a semantic definition of the variable: if its clauses become
+  // unsatisfiable without it, then a core of them defines it. the core
+  // clauses are the gate clauses. returns 1 if a definition is found
+  cls_t local_clauses[MINI_MAX];
+  mutable_t* clauses;
+  mini_set_t active = 0, core;
+  mutable_size_t which_clause;
+  int local;
+  char side;
+
+  mini_reset();
+  for (side = 0; side < 2; side++)
+    {
+      clauses = side ? neg_clauses : pos_clauses;
+      for (which_clause = 0; which_clause < clauses->used; which_clause++)
+	{
+	  local = mini_add_clause(clauses->data[which_clause], var);
+	  if (local == -2)
+	    return 0;
+	  if (local == -1)
+	    continue;
+	  local_clauses[local] = clauses->data[which_clause];
+	  active |= (mini_set_t)1 << local;
+	}
+    }
+
+  core = mini_core(active);
+  if (core == 0)
+    return 0;
+  for (local = 0; local < mini_num_clauses; local++)
+    {
+      if (!((core >> local) & 1))
+	continue;
+      if (cls_contains(local_clauses[local], var))
+	mark_gate_clause(pos_clauses, pos_gates, local_clauses[local]);
+      else
+	mark_gate_clause(neg_clauses, neg_gates, local_clauses[local]);
+    }
+  return 1;
+}
+
+char pre_resolve(cls_t pos_cls, cls_t neg_cls, lit_t var, var_set_size_t* width)
+{
+  // writes the resolvent of the two clauses on var into `resolvent', leaving
+  // out literals false at level 0. returns 0 if the resolvent is tautological
+  // or satisfied, 1 otherwise
+  var_set_size_t which_lit;
+  cls_t cls = pos_cls;
+  lit_t lit;
+
+  stamp++;
+  *width = 0;
+  while (1)
+    {
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	{
+	  lit = cls[which_lit];
+	  if (get_var(lit) == var || lit_value(lit) == NEGATIVE ||
+	      lit_stamps[lit] == stamp)
+	    continue;
+	  if (lit_value(lit) == POSITIVE ||
+	      lit_stamps[get_comp_lit(lit)] == stamp)
+	    return 0;
+	  lit_stamps[lit] = stamp;
+	  resolvent[(*width)++] = lit;
+	}
+      if (cls == neg_cls)
+	return 1;
+      cls = neg_cls;
+    }
+}
+
+void pre_push_extension(cls_t cls, lit_t lit)
+{
+  // moves a clause of an eliminated variable onto the extension stack, with the
+  // literal lit at the front, and removes it from the preprocessed clauses
+  cls_t copy = cls_copy(cls, MEM_EXTENSION);
+  var_set_size_t which_lit;
+
+  for (which_lit = 1; copy[which_lit] != lit; which_lit++)
+    continue;
+  copy[which_lit] = copy[1];
+  copy[1] = lit;
+  mutable_push(&extension_stack, copy);
+  cls[0] = 0;
+}
+
+void pre_push_witness(lit_t lit)
+{
+  // pushes a unit onto the extension stack, which sets lit to true when the
+  // reconstruction reaches it
+  cls_t unit = cls_init(1, MEM_EXTENSION);
+
+  unit[1] = lit;
+  mutable_push(&extension_stack, unit);
+}
+
+// at-most-one detection runs before variable elimination, which leaves the
+// variables of the constraints alone. it recognises two encodings: cliques of
+// binary clauses (-a -b) amongst the literals, and sequential counters over
+// x_1, ..., x_n with auxiliary variables s_1, ..., s_n-1, made of the binary
+// clauses (-x_i s_i), (-s_i-1 s_i) and (-x_i -s_i-1)
+
+lit_t* amo_lits;
+lit_t* counter_auxes;
+var_set_size_t num_clique_lits;
+var_set_size_t* clique_hits;
+unsigned long* clique_rounds;
+unsigned long clique_round;
+
+lit_t binary_other_lit(cls_t cls, lit_t lit)
+{
+  // returns the literal of a binary clause other than lit
+  return (cls[1] == lit) ? cls[2] : cls[1];
+}
+
+char gathered_binaries(mutable_t* gathered, mutable_size_t min, mutable_size_t max)
+{
+  // returns 1 if between min and max clauses were gathered, all binary
+  mutable_size_t which_clause;
+
+  if (gathered->used < min || gathered->used > max)
+    return 0;
+  for (which_clause = 0; which_clause < gathered->used; which_clause++)
+    if (gathered->data[which_clause][0] != 2)
+      return 0;
+  return 1;
+}
+
+char is_counter_aux(lit_t lit)
+{
+  // returns 1 if the literal could be an auxiliary s_i of a sequential counter
+  // past the first: it occurs in exactly two binary clauses, and its complement
+  // in one or two binary clauses only
+  if (eliminated[get_var(lit)] || frozen[get_var(lit)] ||
+      lit_value(lit) != UNASSIGNED)
+    return 0;
+  pre_gather(lit, &pos_clauses);
+  if (!gathered_binaries(&pos_clauses, 2, 2))
+    return 0;
+  pre_gather(get_comp_lit(lit), &neg_clauses);
+  return gathered_binaries(&neg_clauses, 1, 2);
+}
+
+char pre_detect_counter(lit_t aux)
+{
+  // follows a sequential counter starting from the auxiliary literal s_1, and
+  // replaces it by an at-most-one constraint if it covers at least AMO_MIN_SIZE
+  // literals. the auxiliaries are eliminated, with their clauses on the
+  // extension stack so that s_i is reconstructed as x_1 v ... v x_i
+  var_set_size_t num_lits = 0, num_auxes = 0, which_aux, which_lit;
+  mutable_size_t which_clause;
+  lit_t expected = 0, other, next[2];
+  char is_aux[2];
+
+  stamp++;
+  while (1)
+    {
+      if (eliminated[get_var(aux)] || frozen[get_var(aux)] ||
+	  lit_value(aux) != UNASSIGNED || lit_stamps[get_var(aux)] == stamp)
+	return 0;
+      lit_stamps[get_var(aux)] = stamp;
+      pre_gather(aux, &pos_clauses);
+      pre_gather(get_comp_lit(aux), &neg_clauses);
+      if (!gathered_binaries(&pos_clauses, num_auxes ? 2 : 1, num_auxes ? 2 : 1) ||
+	  !gathered_binaries(&neg_clauses, 1, 2))
+	return 0;
+
+      // x_i is the negation of the literal in (-x_i s_i)
+      for (which_clause = 0; which_clause < pos_clauses.used; which_clause++)
+	{
+	  other = binary_other_lit(pos_clauses.data[which_clause], aux);
+	  if (num_auxes == 0 || other != get_comp_lit(counter_auxes[num_auxes - 1]))
+	    break;
+	}
+      if (which_clause == pos_clauses.used ||
+	  (num_auxes > 0 && get_comp_lit(other) != expected))
+	return 0;
+      amo_lits[num_lits++] = get_comp_lit(other);
+      counter_auxes[num_auxes++] = aux;
+
+      // the counter ends with (-x_n -s_n-1)
+      if (neg_clauses.used == 1)
+	{
+	  other = binary_other_lit(neg_clauses.data[0], get_comp_lit(aux));
+	  amo_lits[num_lits++] = get_comp_lit(other);
+	  break;
+	}
+
+      // otherwise one of (-x_i+1 -s_i) and (-s_i s_i+1) leads to the next
+      // auxiliary, which is told apart from x_i+1 by its occurrences
+      next[0] = binary_other_lit(neg_clauses.data[0], get_comp_lit(aux));
+      next[1] = binary_other_lit(neg_clauses.data[1], get_comp_lit(aux));
+      is_aux[0] = is_counter_aux(next[0]);
+      is_aux[1] = is_counter_aux(next[1]);
+      if (is_aux[0] == is_aux[1])
+	return 0;
+      expected = get_comp_lit(next[is_aux[0] ? 1 : 0]);
+      aux = next[is_aux[0] ? 0 : 1];
+    }
+
+  // the constrained literals must belong to distinct variables
+  if (num_lits < AMO_MIN_SIZE)
+    return 0;
+  for (which_lit = 0; which_lit < num_lits; which_lit++)
+    {
+      if (lit_stamps[get_var(amo_lits[which_lit])] == stamp)
+	return 0;
+      lit_stamps[get_var(amo_lits[which_lit])] = stamp;
+    }
+
+  // the last auxiliary goes onto the extension stack first, so that the
+  // reconstruction computes s_1 first. each s_i is reset to false before its
+  // clauses (-x_i s_i) and (-s_i-1 s_i) are replayed
+  for (which_aux = num_auxes; which_aux > 0; which_aux--)
+    {
+      aux = counter_auxes[which_aux - 1];
+      pre_gather(get_comp_lit(aux), &neg_clauses);
+      for (which_clause = 0; which_clause < neg_clauses.used; which_clause++)
+	pre_push_extension(neg_clauses.data[which_clause], get_comp_lit(aux));
+      pre_gather(aux, &pos_clauses);
+      for (which_clause = 0; which_clause < pos_clauses.used; which_clause++)
+	pre_push_extension(pos_clauses.data[which_clause], aux);
+      pre_push_witness(get_comp_lit(aux));
+      eliminated[get_var(aux)] = 1;
+    }
+  amo_add(amo_lits, num_lits);
+  return 1;
+}
+
+void add_clique_member(lit_t lit)
+{
+  // adds the literal to the clique, and counts it once for each literal it
+  // excludes through a binary clause
+  mutable_size_t which_clause;
+  lit_t other;
+
+  amo_lits[num_clique_lits++] = lit;
+  stamp++;
+  pre_gather(get_comp_lit(lit), &neg_clauses);
+  for (which_clause = 0; which_clause < neg_clauses.used; which_clause++)
+    {
+      if (neg_clauses.data[which_clause][0] != 2)
+	continue;
+      other = get_comp_lit(binary_other_lit(neg_clauses.data[which_clause],
+					    get_comp_lit(lit)));
+      if (lit_stamps[other] == stamp)
+	continue;
+      lit_stamps[other] = stamp;
+      if (clique_rounds[other] != clique_round)
+	{
+	  clique_rounds[other] = clique_round;
+	  clique_hits[other] = 0;
+	}
+      clique_hits[other]++;
+    }
+}
+
+void pre_detect_clique(lit_t lit, char* in_amo)
+{
+  // greedily grows a clique of literals around lit, each pair of which is
+  // excluded by a binary clause, and replaces the binary clauses amongst them
+  // by an at-most-one constraint if the clique has at least AMO_MIN_SIZE
+  // literals. a candidate joins if it is excluded by every member so far
+  var_set_size_t which_lit;
+  mutable_size_t which_clause;
+  lit_t candidate;
+
+  clique_round++;
+  num_clique_lits = 0;
+  add_clique_member(lit);
+  pre_gather(get_comp_lit(lit), &pos_clauses);
+  for (which_clause = 0; which_clause < pos_clauses.used; which_clause++)
+    {
+      if (pos_clauses.data[which_clause][0] != 2)
+	continue;
+      candidate = get_comp_lit(binary_other_lit(pos_clauses.data[which_clause],
+						get_comp_lit(lit)));
+      if (!in_amo[candidate] && clique_rounds[candidate] == clique_round &&
+	  clique_hits[candidate] == num_clique_lits)
+	add_clique_member(candidate);
+    }
+  if (num_clique_lits < AMO_MIN_SIZE)
+    return;
+
+  // remove the binary clauses amongst the members
+  stamp++;
+  for (which_lit = 0; which_lit < num_clique_lits; which_lit++)
+    {
+      lit_stamps[amo_lits[which_lit]] = stamp;
+      in_amo[amo_lits[which_lit]] = 1;
+    }
+  for (which_lit = 0; which_lit < num_clique_lits; which_lit++)
+    {
+      lit = get_comp_lit(amo_lits[which_lit]);
+      pre_gather(lit, &neg_clauses);
+      for (which_clause = 0; which_clause < neg_clauses.used; which_clause++)
+	if (neg_clauses.data[which_clause][0] == 2 &&
+	    lit_stamps[get_comp_lit(binary_other_lit(neg_clauses.data[which_clause],
+						     lit))] == stamp)
+	  neg_clauses.data[which_clause][0] = 0;
+    }
+  amo_add(amo_lits, num_clique_lits);
+}
+
+void pre_detect_amos()
+{
+  // replaces at-most-one encodings by native at-most-one constraints
+  var_set_size_t which_var;
+  model_size_t which_ass;
+  char* in_amo;
+
+  if ((amo_lits = (lit_t*)mem_alloc(MEM_PREPROCESSING, sizeof(lit_t) * num_vars)) == NULL ||
+      (counter_auxes = (lit_t*)mem_alloc(MEM_PREPROCESSING, sizeof(lit_t) * num_vars)) == NULL)
+    error("cannot allocate at-most-one detection");
+
+  // sequential counters start with an auxiliary s_1 that occurs in one binary
+  // clause (-x_1 s_1), and negated in two
+  for (which_var = 0; which_var < num_vars; which_var++)
+    {
+      if (eliminated[which_var] || lit_value(which_var) != UNASSIGNED)
+	continue;
+      pre_gather(which_var, &pos_clauses);
+      pre_gather(get_comp_lit(which_var), &neg_clauses);
+      if (gathered_binaries(&pos_clauses, 1, 1) && gathered_binaries(&neg_clauses, 2, 2))
+	pre_detect_counter(which_var);
+      else if (gathered_binaries(&pos_clauses, 2, 2) && gathered_binaries(&neg_clauses, 1, 1))
+	pre_detect_counter(get_comp_lit(which_var));
+    }
+
+  // cliques are grown from each literal not yet constrained
+  if ((in_amo = (char*)mem_calloc(MEM_PREPROCESSING, num_asses, sizeof(char))) == NULL ||
+      (clique_hits = (var_set_size_t*)mem_alloc(MEM_PREPROCESSING, sizeof(var_set_size_t) * num_asses)) == NULL ||
+      (clique_rounds = (unsigned long*)mem_calloc(MEM_PREPROCESSING, num_asses, sizeof(unsigned long))) == NULL)
+    error("cannot allocate clique detection");
+  clique_round = 0;
+  for (which_ass = 0; which_ass < num_asses; which_ass++)
+    if (!in_amo[which_ass] && !eliminated[get_var(which_ass)] &&
+	lit_value(which_ass) == UNASSIGNED)
+      pre_detect_clique(which_ass, in_amo);
+
+  mem_free(in_amo);
+  mem_free(clique_hits);
+  mem_free(clique_rounds);
+  mem_free(amo_lits);
+  mem_free(counter_auxes);
+}
+
+// sweeping runs between at-most-one detection and variable elimination,
+// while the gates of the formula are still intact. it simulates the gates on
+// random patterns, groups variables whose signatures are equal or complementary,
+// proves each candidate equivalence with the mini solver on the gate clauses
+// around the two variables, and substitutes the proven ones
+
+// the gate clauses of each gate output, stored contiguously in variable order,
+// and SIM_WORDS words of simulated values per variable
+mutable_t gate_clauses;
+mutable_size_t* gate_starts;
+sim_word_t* sim;
+uint64_t sim_seed;
+
+sim_word_t sim_random()
+{
+  // xorshift64
+  sim_seed ^= sim_seed << 13;
+  sim_seed ^= sim_seed >> 7;
+  sim_seed ^= sim_seed << 17;
+  return sim_seed;
+}
+
+sim_word_t sim_lit(lit_t lit, int word)
+{
+  // the simulated values of a literal
+  return lit < num_vars ? sim[lit * SIM_WORDS + word] :
+    ~sim[(lit - num_vars) * SIM_WORDS + word];
+}
+
+void sweep_find_gates()
+{
+  // records the gate clauses of every variable that is the output of a
+  // syntactic gate
+  lit_t var;
+  mutable_size_t pos_gates, neg_gates, which_clause;
+
+  mutable_init(&gate_clauses, MEM_PREPROCESSING);
+  if ((gate_starts = (mutable_size_t*)mem_alloc(MEM_PREPROCESSING, sizeof(mutable_size_t) *
+					     (num_vars + 1))) == NULL)
+    error("cannot allocate gates");
+  for (var = 0; var < num_vars; var++)
+    {
+      gate_starts[var] = gate_clauses.used;
+      if (eliminated[var] || lit_value(var) != UNASSIGNED)
+	continue;
+      pos_gates = neg_gates = 0;
+      pre_gather(var, &pos_clauses);
+      pre_gather(get_comp_lit(var), &neg_clauses);
+      if (find_and_gate(var, &pos_clauses, &pos_gates, &neg_clauses, &neg_gates) == 0 &&
+	  find_and_gate(get_comp_lit(var), &neg_clauses, &neg_gates,
+			&pos_clauses, &pos_gates) == 0 &&
+	  find_ite_gate(var, &pos_clauses, &pos_gates, &neg_clauses, &neg_gates) == 0)
+	continue;
+      for (which_clause = 0; which_clause < pos_gates; which_clause++)
+	mutable_push(&gate_clauses, pos_clauses.data[which_clause]);
+      for (which_clause = 0; which_clause < neg_gates; which_clause++)
+	mutable_push(&gate_clauses, neg_clauses.data[which_clause]);
+    }
+  gate_starts[num_vars] = gate_clauses.used;
+}
+
+void sweep_simulate_gate(lit_t var)
+{
+  // the output of a gate is true exactly when one of its clauses containing
+  // the positive literal has all its other literals false
+  mutable_size_t which_clause;
+  var_set_size_t which_lit;
+  sim_word_t value, term;
+  cls_t cls;
+  int word;
+
+  for (word = 0; word < SIM_WORDS; word++)
+    {
+      value = 0;
+      for (which_clause = gate_starts[var]; which_clause < gate_starts[var + 1];
+	   which_clause++)
+	{
+	  cls = gate_clauses.data[which_clause];
+	  if (!cls_contains(cls, var))
+	    continue;
+	  term = ~(sim_word_t)0;
+	  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	    if (cls[which_lit] != var)
+	      term &= ~sim_lit(cls[which_lit], word);
+	  value |= term;
+	}
+      sim[var * SIM_WORDS + word] = value;
+    }
+}
+
+void sweep_simulate()
+{
+  // gives every variable random values, then simulates the gates with their
+  // inputs first. an input on a cycle of gates keeps its random values
+  char* sim_states; // 0 new, 1 pushed, 2 expanded, 3 simulated
+  lit_t* stack, *new_stack;
+  mutable_size_t stack_size, stack_capacity, which_clause;
+  var_set_size_t which_lit, which_word;
+  lit_t var, top, input;
+  cls_t cls;
+
+  for (which_word = 0; which_word < num_vars * SIM_WORDS; which_word++)
+    sim[which_word] = sim_random();
+  if ((sim_states = (char*)mem_calloc(MEM_PREPROCESSING, num_vars, sizeof(char))) == NULL ||
+      (stack = (lit_t*)mem_alloc(MEM_PREPROCESSING, sizeof(lit_t) * (num_vars + 1))) == NULL)
+    error("cannot allocate simulation");
+  stack_capacity = num_vars + 1;
+
+  for (var = 0; var < num_vars; var++)
+    {
+      if (gate_starts[var] == gate_starts[var + 1] || sim_states[var] != 0)
+	continue;
+      stack_size = 0;
+      stack[stack_size++] = var;
+      sim_states[var] = 1;
+      while (stack_size > 0)
+	{
+	  top = stack[stack_size - 1];
+	  if (sim_states[top] == 3)
+	    {
+	      stack_size--;
+	      continue;
+	    }
+	  if (sim_states[top] == 2)
+	    {
+	      sweep_simulate_gate(top);
+	      sim_states[top] = 3;
+	      stack_size--;
+	      continue;
+	    }
+
+	  // push the inputs that are gate outputs and not yet expanded. an input
+	  // pushed before, but not expanded, is pushed again to come first
+	  sim_states[top] = 2;
+	  for (which_clause = gate_starts[top]; which_clause < gate_starts[top + 1];
+	       which_clause++)
+	    {
+	      cls = gate_clauses.data[which_clause];
+	      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+		{
+		  input = get_var(cls[which_lit]);
+		  if (input == top || gate_starts[input] == gate_starts[input + 1] ||
+		      sim_states[input] >= 2)
+		    continue;
+		  if (stack_size == stack_capacity)
+		    {
+		      stack_capacity *= 2;
+		      if ((new_stack = (lit_t*)mem_realloc(stack, sizeof(lit_t) *
+						       stack_capacity)) == NULL)
+			error("cannot allocate simulation");
+		      stack = new_stack;
+		    }
+		  stack[stack_size++] = input;
+		  sim_states[input] = 1;
+		}
+	    }
+	}
+    }
+  mem_free(sim_states);
+  mem_free(stack);
+}
+
+sim_word_t sim_normal(lit_t var, int word)
+{
+  // the signature of a variable, complemented if its first pattern is true,
+  // so that complementary variables get equal signatures
+  return sim[var * SIM_WORDS + word] ^
+    ((sim[var * SIM_WORDS] & 1) ? ~(sim_word_t)0 : 0);
+}
+
+char same_signature(lit_t var, lit_t other_var)
+{
+  // returns 1 if the normalised signatures of the variables are equal
+  int word;
+
+  for (word = 0; word < SIM_WORDS; word++)
+    if (sim_normal(var, word) != sim_normal(other_var, word))
+      return 0;
+  return 1;
+}
+
+int compare_signatures(const void* var, const void* other_var)
+{
+  // orders variables by their normalised signatures, then by index
+  sim_word_t signature, other_signature;
+  int word;
+
+  for (word = 0; word < SIM_WORDS; word++)
+    {
+      signature = sim_normal(*(lit_t*)var, word);
+      other_signature = sim_normal(*(lit_t*)other_var, word);
+      if (signature != other_signature)
+	return (signature > other_signature) - (signature < other_signature);
+    }
+  return (*(lit_t*)var > *(lit_t*)other_var) - (*(lit_t*)var < *(lit_t*)other_var);
+}
+
+void sweep_environment(lit_t var, lit_t other_var)
+{
+  // loads the gate clauses around the two variables into the mini solver,
+  // breadth first through the gate inputs, until it is full
+  lit_t queue[MINI_MAX];
+  int queue_head = 0, queue_tail = 0;
+  mutable_size_t which_clause;
+  var_set_size_t which_lit;
+  lit_t input;
+  cls_t cls;
+
+  mini_reset();
+  stamp++;
+  queue[queue_tail++] = var;
+  queue[queue_tail++] = other_var;
+  lit_stamps[var] = stamp;
+  lit_stamps[other_var] = stamp;
+  while (queue_head < queue_tail)
+    {
+      var = queue[queue_head++];
+      for (which_clause = gate_starts[var]; which_clause < gate_starts[var + 1];
+	   which_clause++)
+	{
+	  cls = gate_clauses.data[which_clause];
+	  if (cls[0] == 0)
+	    continue;
+	  if (mini_add_clause(cls, num_vars) == -2)
+	    return;
+	  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	    {
+	      input = get_var(cls[which_lit]);
+	      if (lit_stamps[input] != stamp && queue_tail < MINI_MAX)
+		{
+		  lit_stamps[input] = stamp;
+		  queue[queue_tail++] = input;
+		}
+	    }
+	}
+    }
+}
+
+char sweep_prove(lit_t lit, lit_t other_lit)
+{
+  // returns 1 if the mini solver shows that the two literals are equivalent
+  // under the gate clauses around them, 0 otherwise
+  int local, other_local;
+  mini_set_t bit, other_bit;
+  char same, proved;
+
+  sweep_environment(get_var(lit), get_var(other_lit));
+  local = mini_local(get_var(lit));
+  other_local = mini_local(get_var(other_lit));
+  if (local == -1 || other_local == -1)
+    return 0;
+  bit = (mini_set_t)1 << local;
+  other_bit = (mini_set_t)1 << other_local;
+  same = (lit < num_vars) == (other_lit < num_vars);
+
+  // the literals differ if one variable is true and the other takes the
+  // value that makes the literals different, or the other way round. with a
+  // proof, the two refutations leave the binary clauses of the equivalence in
+  // it
+  mini_proof = proof_file != NULL;
+  proved = mini_solve(~(mini_set_t)0, bit | (same ? 0 : other_bit),
+		      same ? other_bit : 0) == UNSAT;
+  if (proved)
+    {
+      mini_steps = 0;
+      proved = mini_solve(~(mini_set_t)0, same ? other_bit : 0,
+			  bit | (same ? 0 : other_bit)) == UNSAT;
+    }
+  mini_proof = 0;
+  return proved;
+}
+
+void sweep_substitute(lit_t* reprs)
+{
+  // replaces every literal by its representative in the preprocessed clauses,
+  // and keeps the equivalences on the extension stack
+  mutable_size_t which_clause, num_clauses = pre_clauses.used;
+  var_set_size_t which_lit, width;
+  char tautology;
+  lit_t var, lit;
+  cls_t cls, new_cls;
+
+  for (which_clause = 0; which_clause < num_clauses; which_clause++)
+    {
+      cls = pre_clauses.data[which_clause];
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	if (reprs[cls[which_lit]] != cls[which_lit])
+	  break;
+      if (which_lit > cls[0])
+	continue;
+
+      stamp++;
+      tautology = 0;
+      width = 0;
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	{
+	  lit = reprs[cls[which_lit]];
+	  if (lit_stamps[get_comp_lit(lit)] == stamp ||
+	      lit_value(lit) == POSITIVE)
+	    tautology = 1;
+	  if (lit_stamps[lit] == stamp || lit_value(lit) == NEGATIVE)
+	    continue;
+	  lit_stamps[lit] = stamp;
+	  resolvent[width++] = lit;
+	}
+      // the new clause follows from the old one and the equivalences, so the
+      // old one is deleted from the proof after it
+      if (!tautology && width == 0)
+	{
+	  proof_add(resolvent, 0);
+	  unsat_found = 1;
+	}
+      else if (!tautology && width == 1)
+	pre_add_unit(resolvent[0]);
+      else if (!tautology)
+	{
+	  proof_add(resolvent, width);
+	  new_cls = cls_init(width, MEM_CLAUSES);
+	  for (which_lit = 1; which_lit <= width; which_lit++)
+	    new_cls[which_lit] = resolvent[which_lit - 1];
+	  pre_add_clause(new_cls);
+	}
+      proof_delete(cls + 1, cls[0]);
+      cls[0] = 0;
+    }
+
+  // var = repr is kept as the clauses (var -repr) and (-var repr), which leave
+  // the proof with the variable
+  for (var = 0; var < num_vars; var++)
+    {
+      if (reprs[var] == var)
+	continue;
+      new_cls = cls_init(2, MEM_EXTENSION);
+      new_cls[1] = var;
+      new_cls[2] = get_comp_lit(reprs[var]);
+      mutable_push(&extension_stack, new_cls);
+      proof_delete(new_cls + 1, 2);
+      new_cls = cls_init(2, MEM_EXTENSION);
+      new_cls[1] = get_comp_lit(var);
+      new_cls[2] = reprs[var];
+      mutable_push(&extension_stack, new_cls);
+      proof_delete(new_cls + 1, 2);
+      eliminated[var] = 1;
+      num_swept++;
+    }
+}
+
+void pre_sweep()
+{
+  // finds and substitutes equivalent variables
+  lit_t* candidates, *reprs;
+  var_set_size_t num_candidates, which_candidate, first, which_var;
+  lit_t var, repr, lit;
+  model_size_t which_ass;
+  int word;
+
+  if ((candidates = (lit_t*)mem_alloc(MEM_PREPROCESSING, sizeof(lit_t) * num_vars)) == NULL ||
+      (reprs = (lit_t*)mem_alloc(MEM_PREPROCESSING, sizeof(lit_t) * num_asses)) == NULL ||
+      (sim = (sim_word_t*)mem_alloc(MEM_PREPROCESSING, sizeof(sim_word_t) * num_vars * SIM_WORDS)) == NULL)
+    error("cannot allocate sweeping");
+  sim_seed = 0x9e3779b97f4a7c15ULL;
+  sweep_find_gates();
+  sweep_simulate();
+
+  num_candidates = 0;
+  for (which_var = 0; which_var < num_vars; which_var++)
+    if (!eliminated[which_var] && lit_value(which_var) == UNASSIGNED &&
+	!var_in_amo(which_var))
+      candidates[num_candidates++] = which_var;
+  qsort(candidates, num_candidates, sizeof(lit_t), compare_signatures);
+  for (which_ass = 0; which_ass < num_asses; which_ass++)
+    reprs[which_ass] = which_ass;
+
+  // each run of equal signatures is a class, whose first variable is tried as
+  // the representative of the others. constant signatures are left alone
+  for (first = 0; first < num_candidates; first = which_candidate)
+    {
+      var = candidates[first];
+      for (which_candidate = first + 1; which_candidate < num_candidates &&
+	     same_signature(var, candidates[which_candidate]); which_candidate++)
+	continue;
+      for (word = 0; word < SIM_WORDS && sim_normal(var, word) == 0; word++)
+	continue;
+      if (word == SIM_WORDS)
+	continue;
+      repr = (sim[var * SIM_WORDS] & 1) ? get_comp_lit(var) : var;
+      for (which_var = first + 1; which_var < which_candidate; which_var++)
+	{
+	  lit = candidates[which_var];
+	  if (frozen[lit])
+	    continue;
+	  if (sim[lit * SIM_WORDS] & 1)
+	    lit = get_comp_lit(lit);
+	  if (!sweep_prove(lit, repr))
+	    continue;
+	  reprs[lit] = repr;
+	  reprs[get_comp_lit(lit)] = get_comp_lit(repr);
+	}
+    }
+
+  sweep_substitute(reprs);
+
+  mutable_free(&gate_clauses);
+  mem_free(gate_starts);
+  mem_free(sim);
+  mem_free(candidates);
+  mem_free(reprs);
+}
+
+// autarky detection starts from the preferred phases of the variables and
+// unassigns the variables of every clause the assignment touches but does not
+// satisfy, until no such clause is left. the remaining assignment satisfies
+// every clause it touches, so those clauses can be removed with it.
+// variables of at-most-one constraints are left out of the assignment
+
+truth_value_t* autarky;
+lit_t* autarky_unassigned;
+var_set_size_t num_autarky_unassigned;
+
+char autarky_satisfies(cls_t cls)
+{
+  // returns 1 if the autarky assignment makes a literal of the clause true
+  var_set_size_t which_lit;
+  lit_t lit;
+
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    {
+      lit = cls[which_lit];
+      if (autarky[get_var(lit)] == (lit < num_vars ? POSITIVE : NEGATIVE))
+	return 1;
+    }
+  return 0;
+}
+
+void autarky_check(cls_t cls)
+{
+  // unassigns the variables of the clause if the assignment touches it
+  // without satisfying it, remembering the literals that were true
+  var_set_size_t which_lit;
+  lit_t var;
+
+  if (cls[0] == 0 || cls_is_satisfied(cls) || autarky_satisfies(cls))
+    return;
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    {
+      var = get_var(cls[which_lit]);
+      if (autarky[var] == UNASSIGNED)
+	continue;
+      autarky_unassigned[num_autarky_unassigned++] =
+	autarky[var] == POSITIVE ? var : get_comp_lit(var);
+      autarky[var] = UNASSIGNED;
+    }
+}
+
+void pre_autarky()
+{
+  // finds an autarky, and moves the clauses it satisfies onto the extension
+  // stack, followed by units for its literals
+  mutable_size_t which_clause;
+  mutable_t* occ;
+  lit_t var, lit;
+  var_set_size_t which_lit;
+  cls_t cls;
+
+  if ((autarky = (truth_value_t*)mem_alloc(MEM_PREPROCESSING, sizeof(truth_value_t) * num_vars)) == NULL ||
+      (autarky_unassigned = (lit_t*)mem_alloc(MEM_PREPROCESSING, sizeof(lit_t) * num_vars)) == NULL)
+    error("cannot allocate autarky");
+  for (var = 0; var < num_vars; var++)
+    autarky[var] = (eliminated[var] || frozen[var] ||
+		    lit_value(var) != UNASSIGNED || var_in_amo(var)) ?
+      UNASSIGNED : phases[var];
+
+  // check every clause, then the clauses that lost a true literal
+  num_autarky_unassigned = 0;
+  for (which_clause = 0; which_clause < pre_clauses.used; which_clause++)
+    autarky_check(pre_clauses.data[which_clause]);
+  while (num_autarky_unassigned > 0)
+    {
+      lit = autarky_unassigned[--num_autarky_unassigned];
+      occ = occs + lit;
+      for (which_clause = 0; which_clause < occ->used; which_clause++)
+	autarky_check(occ->data[which_clause]);
+    }
+
+  for (which_clause = 0; which_clause < pre_clauses.used; which_clause++)
+    {
+      cls = pre_clauses.data[which_clause];
+      if (cls[0] == 0 || cls_is_satisfied(cls))
+	continue;
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	{
+	  lit = cls[which_lit];
+	  if (autarky[get_var(lit)] == (lit < num_vars ? POSITIVE : NEGATIVE))
+	    break;
+	}
+      if (which_lit > cls[0])
+	continue;
+      proof_delete(cls + 1, cls[0]);
+      pre_push_extension(cls, lit);
+      num_autarky_clauses++;
+    }
+  for (var = 0; var < num_vars; var++)
+    {
+      if (autarky[var] == UNASSIGNED)
+	continue;
+      pre_push_witness(autarky[var] == POSITIVE ? var : get_comp_lit(var));
+      eliminated[var] = 1;
+      num_autarky_vars++;
+    }
+  mem_free(autarky);
+  mem_free(autarky_unassigned);
+}
+
+char pre_eliminate(lit_t var)
+{
+  // eliminates the variable by clause distribution if this does not increase
+  // the number of clauses. if the variable is defined by a gate, the
+  // resolvents amongst non-gate clauses are implied by those of gate clauses
+  // and are skipped. so are the resolvents amongst the clauses of a syntactic
+  // gate, which are tautological. returns 1 if the variable was eliminated,
+  // 0 otherwise
+  lit_t comp_var = get_comp_lit(var);
+  mutable_size_t pos_gates = 0, neg_gates = 0;
+  mutable_size_t which_pos, which_neg, num_resolvents = 0;
+  var_set_size_t width, which_lit;
+  var_set_size_t and_width;
+  char ite_type = 0;
+  char semantic = 0;
+  char pass;
+  cls_t cls;
+
+  pre_gather(var, &pos_clauses);
+  pre_gather(comp_var, &neg_clauses);
+  if (pos_clauses.used + neg_clauses.used > ELIM_OCC_LIMIT ||
+      pos_clauses.used + neg_clauses.used == 0)
+    return 0;
+
+  // look for a gate with either polarity of the variable as output
+  and_width = find_and_gate(var, &pos_clauses, &pos_gates,
+			    &neg_clauses, &neg_gates);
+  if (and_width == 0)
+    and_width = find_and_gate(comp_var, &neg_clauses, &neg_gates,
+			      &pos_clauses, &pos_gates);
+  if (and_width == 0)
+    ite_type = find_ite_gate(var, &pos_clauses, &pos_gates,
+			     &neg_clauses, &neg_gates);
+  if (and_width == 0 && ite_type == 0)
+    semantic = find_definition(var, &pos_clauses, &pos_gates,
+			       &neg_clauses, &neg_gates);
+
+  // the first pass counts the resolvents, the second adds them
+  for (pass = 0; pass < 2; pass++)
+    for (which_pos = 0; which_pos < pos_clauses.used; which_pos++)
+      for (which_neg = 0; which_neg < neg_clauses.used; which_neg++)
+	{
+	  if (pos_gates + neg_gates > 0 &&
+	      which_pos >= pos_gates && which_neg >= neg_gates)
+	    continue;
+	  if (!semantic && which_pos < pos_gates && which_neg < neg_gates)
+	    continue;
+	  if (!pre_resolve(pos_clauses.data[which_pos], neg_clauses.data[which_neg],
+			   var, &width))
+	    continue;
+	  if (pass == 0)
+	    {
+	      if (width > ELIM_CLS_LIMIT ||
+		  ++num_resolvents > pos_clauses.used + neg_clauses.used)
+		return 0;
+	      continue;
+	    }
+	  if (width == 0)
+	    {
+	      proof_add(resolvent, 0);
+	      unsat_found = 1;
+	      continue;
+	    }
+	  if (width == 1)
+	    {
+	      pre_add_unit(resolvent[0]);
+	      continue;
+	    }
+	  proof_add(resolvent, width);
+	  cls = cls_init(width, MEM_CLAUSES);
+	  for (which_lit = 1; which_lit <= width; which_lit++)
+	    cls[which_lit] = resolvent[which_lit - 1];
+	  pre_add_clause(cls);
+	}
+
+  // move the clauses of the variable onto the extension stack, deleting them
+  // from the proof
+  for (which_pos = 0; which_pos < pos_clauses.used; which_pos++)
+    {
+      cls = pos_clauses.data[which_pos];
+      proof_delete(cls + 1, cls[0]);
+      pre_push_extension(cls, var);
+    }
+  for (which_neg = 0; which_neg < neg_clauses.used; which_neg++)
+    {
+      cls = neg_clauses.data[which_neg];
+      proof_delete(cls + 1, cls[0]);
+      pre_push_extension(cls, comp_var);
+    }
+
+  eliminated[var] = 1;
+  num_eliminated++;
+  if (and_width == 1)
+    num_equiv_gates++;
+  else if (and_width > 1)
+    num_and_gates++;
+  else if (ite_type == 1)
+    num_ite_gates++;
+  else if (ite_type == 2)
+    num_xor_gates++;
+  else if (semantic)
+    num_semantic_gates++;
+  return 1;
+}
+
+int compare_occurrences(const void* var, const void* other_var)
+{
+  // orders variables by their number of occurrences
+  mutable_size_t occurrences, other_occurrences;
+
+  occurrences = occs[*(lit_t*)var].used +
+    occs[get_comp_lit(*(lit_t*)var)].used;
+  other_occurrences = occs[*(lit_t*)other_var].used +
+    occs[get_comp_lit(*(lit_t*)other_var)].used;
+  return (occurrences > other_occurrences) - (occurrences < other_occurrences);
+}
+
+void pre_eliminate_vars()
+{
+  // tries to eliminate every unassigned variable, fewest occurrences first,
+  // until a round eliminates nothing
+  lit_t* candidates;
+  var_set_size_t num_candidates, which_candidate, which_var;
+  unsigned long num_eliminated_before;
+  char round;
+
+  if ((candidates = (lit_t*)mem_alloc(MEM_PREPROCESSING, sizeof(lit_t) * num_vars)) == NULL)
+    error("cannot allocate elimination candidates");
+
+  for (round = 0; round < ELIM_ROUNDS; round++)
+    {
+      num_candidates = 0;
+      for (which_var = 0; which_var < num_vars; which_var++)
+	if (!eliminated[which_var] && !frozen[which_var] &&
+	    lit_value(which_var) == UNASSIGNED && !var_in_amo(which_var))
+	  candidates[num_candidates++] = which_var;
+      qsort(candidates, num_candidates, sizeof(lit_t), compare_occurrences);
+
+      num_eliminated_before = num_eliminated;
+      for (which_candidate = 0; which_candidate < num_candidates; which_candidate++)
+	if (lit_value(candidates[which_candidate]) == UNASSIGNED)
+	  pre_eliminate(candidates[which_candidate]);
+      if (num_eliminated == num_eliminated_before)
+	break;
+    }
+  mem_free(candidates);
+}
+
+void pre_finish()
+{
+  // writes the remaining clauses back into the cnf, removing literals false at
+  // level 0, frees the preprocessing data and watches the new clauses
+  mutable_size_t which_clause, kept;
+  model_size_t which_ass;
+  var_set_size_t which_lit, width;
+  cls_t cls;
+
+  cnf_capacity = pre_clauses.used + 1;
+  if ((cnf.clauses = (cls_t*)mem_alloc(MEM_CLAUSES, sizeof(cls_t) * cnf_capacity)) == NULL)
+    error("cannot allocate cnf clauses");
+  cnf.size = 0;
+  for (which_clause = 0; which_clause < pre_clauses.used; which_clause++)
+    {
+      cls = pre_clauses.data[which_clause];
+      if (cls[0] == 0 || cls_is_satisfied(cls))
+	{
+	  cls_free(cls);
+	  continue;
+	}
+      proof_strengthen(cls);
+      width = 0;
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	if (lit_value(cls[which_lit]) != NEGATIVE)
+	  cls[++width] = cls[which_lit];
+      cls[0] = width;
+      if (width == 0)
+	unsat_found = 1;
+      if (width <= 1)
+	{
+	  if (width == 1)
+	    pre_add_unit(cls[1]);
+	  cls_free(cls);
+	  continue;
+	}
+      cnf.clauses[cnf.size++] = cls;
+    }
+
+  for (which_ass = 0; which_ass < num_asses; which_ass++)
+    mutable_free(occs + which_ass);
+  mem_free(occs);
+  mem_free(lit_stamps);
+  mem_free(resolvent);
+  mutable_free(&pos_clauses);
+  mutable_free(&neg_clauses);
+  mutable_free(&pre_clauses);
+
+  // clauses learned before a simplification between incremental calls are
+  // kept if they lost no variable, without their literals false at level 0
+  kept = 0;
+  for (which_clause = 0; which_clause < learned_cnf.used; which_clause++)
+    {
+      cls = learned_cnf.data[which_clause];
+      width = 0;
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	if (eliminated[get_var(cls[which_lit])] ||
+	    lit_value(cls[which_lit]) == POSITIVE)
+	  break;
+	else if (lit_value(cls[which_lit]) == UNASSIGNED)
+	  cls[++width] = cls[which_lit];
+      if (which_lit <= cls[0] || width <= 1)
+	{
+	  if (which_lit > cls[0])
+	    {
+	      if (width == 0)
+		unsat_found = 1;
+	      else
+		pre_add_unit(cls[1]);
+	    }
+	  cls_free(cls);
+	  continue;
+	}
+      cls[0] = width;
+      learned_cnf.data[kept++] = cls;
+    }
+  learned_cnf.used = kept;
+
+  // watch the first two literals of every clause
+  for (which_ass = 0; which_ass < num_asses; which_ass++)
+    model[which_ass].watched_lits.used = 0;
+  for (which_clause = 0; which_clause < cnf.size; which_clause++)
+    {
+      cls = cnf.clauses[which_clause];
+      mutable_push(&(model[get_comp_lit(cls[1])].watched_lits), cls);
+      mutable_push(&(model[get_comp_lit(cls[2])].watched_lits), cls);
+    }
+  for (which_clause = 0; which_clause < learned_cnf.used; which_clause++)
+    {
+      cls = learned_cnf.data[which_clause];
+      mutable_push(&(model[get_comp_lit(cls[1])].watched_lits), cls);
+      mutable_push(&(model[get_comp_lit(cls[2])].watched_lits), cls);
+    }
+}
+
+// INCREMENTAL RELATED FUNCTIONS
+
+// between incremental calls the solver returns to level 0, and the values of
+// the eliminated variables set by model reconstruction are cleared. clauses
+// are added at level 0, and an eliminated variable used by a new clause or
+// frozen is reintroduced with the clauses of the extension stack containing it
+
+void incremental_reset()
+{
+  // returns to level 0, keeping the level 0 literals still to propagate
+  if (dec_level > 0)
+    backtrack(0);
+  while (num_reconstructed > 0)
+    unassign_by_lit(reconstructed[--num_reconstructed]);
+}
+
+lit_t grow_lit(lit_t lit, lit_t old_num_vars)
+{
+  // the literal of the smaller solver once num_vars has grown
+  return lit < old_num_vars ? lit : lit - old_num_vars + num_vars;
+}
+
+void grow_clauses(cls_t* clauses, mutable_size_t num_clauses, lit_t old_num_vars)
+{
+  mutable_size_t which_clause;
+  var_set_size_t which_lit;
+  cls_t cls;
+
+  for (which_clause = 0; which_clause < num_clauses; which_clause++)
+    {
+      cls = clauses[which_clause];
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	cls[which_lit] = grow_lit(cls[which_lit], old_num_vars);
+    }
+}
+
+void incremental_grow(lit_t new_num_vars)
+{
+  // makes room for new_num_vars variables after an incremental reset, which
+  // moves every negative literal up. the new variables are unassigned, and
+  // come last in the decision order with false phases. interpolation, the
+  // portfolio and at-most-one constraints are not supported
+  lit_t old_num_vars = num_vars, var, *trail_lits;
+  var_set_size_t which_assumption;
+  mutable_size_t head, tail, which_entry;
+
+  if (new_num_vars <= num_vars)
+    return;
+  if (itp_filename != NULL || arena != NULL || amo_watches != NULL)
+    error("cannot grow the solver");
+  num_vars = new_num_vars;
+  num_asses = 2 * num_vars;
+
+  // the model, with the watches of each literal, and the trail into it, which
+  // holds the literals of its assignments while the model moves
+  head = trail.head - trail.sequence;
+  tail = trail.tail - trail.sequence;
+  if ((trail_lits = (lit_t*)mem_alloc(MEM_TRAIL, sizeof(lit_t) * (tail + 1))) == NULL)
+    error("cannot allocate trail sequence");
+  for (which_entry = 0; which_entry < tail; which_entry++)
+    trail_lits[which_entry] = trail.sequence[which_entry] - model;
+  if ((model = (ass_t*)mem_realloc(model, sizeof(ass_t) * num_asses)) == NULL ||
+      (trail.sequence = (ass_t**)mem_realloc(trail.sequence, sizeof(ass_t*) * num_asses)) == NULL)
+    error("cannot allocate model");
+  memmove(model + num_vars, model + old_num_vars, sizeof(ass_t) * old_num_vars);
+#ifdef PACKED_MODEL
+  if ((packed_model = (uint64_t*)mem_realloc(packed_model, sizeof(uint64_t) * ((num_vars + 31) / 32))) == NULL)
+    error("cannot allocate packed model");
+  for (var = (old_num_vars + 31) / 32; var < (num_vars + 31) / 32; var++)
+    packed_model[var] = 0;
+#endif
+  for (var = old_num_vars; var < num_vars; var++)
+    {
+      value_set(var, UNASSIGNED);
+      mutable_init(&(model[var].watched_lits), MEM_WATCHES);
+      mutable_init(&(model[get_comp_lit(var)].watched_lits), MEM_WATCHES);
+    }
+  trail.head = trail.sequence + head;
+  trail.tail = trail.sequence + tail;
+  for (which_entry = 0; which_entry < tail; which_entry++)
+    trail.sequence[which_entry] = model + grow_lit(trail_lits[which_entry], old_num_vars);
+  mem_free(trail_lits);
+
+  // the literals of the clauses and the assumptions
+  grow_clauses(cnf.clauses, cnf.size, old_num_vars);
+  grow_clauses(learned_cnf.data, learned_cnf.used, old_num_vars);
+  grow_clauses(extension_stack.data, extension_stack.used, old_num_vars);
+  for (which_assumption = 0; which_assumption < num_assumptions; which_assumption++)
+    assumptions[which_assumption] = grow_lit(assumptions[which_assumption], old_num_vars);
+  mem_free(extension_occs);
+  mem_free(extension_starts);
+  extension_occs = NULL;
+  extension_starts = NULL;
+
+  // the scratch space of conflict analysis, and the arrays of variables
+  if ((seen = (char*)mem_realloc(seen, sizeof(char) * num_vars)) == NULL ||
+      (learned_lits = (lit_t*)mem_realloc(learned_lits, sizeof(lit_t) * (num_vars + 1))) == NULL ||
+      (seen_vars = (lit_t*)mem_realloc(seen_vars, sizeof(lit_t) * (num_vars + 1))) == NULL ||
+      (level_counts = (var_set_size_t*)mem_realloc(level_counts, sizeof(var_set_size_t) * (num_vars + 1))) == NULL ||
+      (bin_stamps = (unsigned long*)mem_realloc(bin_stamps, sizeof(unsigned long) * num_asses)) == NULL ||
+      (eliminated = (char*)mem_realloc(eliminated, sizeof(char) * num_vars)) == NULL ||
+      (frozen = (unsigned*)mem_realloc(frozen, sizeof(unsigned) * num_vars)) == NULL ||
+      (reconstructed = (lit_t*)mem_realloc(reconstructed, sizeof(lit_t) * num_vars)) == NULL ||
+      (var_order = (lit_t*)mem_realloc(var_order, sizeof(lit_t) * num_vars)) == NULL ||
+      (phases = (truth_value_t*)mem_realloc(phases, sizeof(truth_value_t) * num_vars)) == NULL)
+    error("cannot grow the solver");
+  memset(bin_stamps, 0, sizeof(unsigned long) * num_asses);
+  for (var = old_num_vars; var < num_vars; var++)
+    {
+      seen[var] = 0;
+      level_counts[var + 1] = 0;
+      eliminated[var] = 0;
+      frozen[var] = 0;
+      var_order[var] = var;
+      phases[var] = NEGATIVE;
+    }
+  if (jw_scores != NULL)
+    {
+      if ((jw_scores = (double*)mem_realloc(jw_scores, sizeof(double) * num_asses)) == NULL)
+	error("cannot grow the solver");
+      memmove(jw_scores + num_vars, jw_scores + old_num_vars, sizeof(double) * old_num_vars);
+      for (var = old_num_vars; var < num_vars; var++)
+	jw_scores[var] = jw_scores[var + num_vars] = 0;
+    }
+}
+
+void incremental_add(cls_t cls)
+{
+  // adds the clause to the formula at level 0, without duplicate literals and
+  // literals false at level 0. a unit is assigned and an empty clause makes
+  // the formula unsatisfiable
+  var_set_size_t which_lit, other_lit, width = 0;
+
+  for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+    {
+      if (lit_value(cls[which_lit]) == POSITIVE)
+	break;
+      if (lit_value(cls[which_lit]) == NEGATIVE)
+	continue;
+      for (other_lit = 1; other_lit <= width; other_lit++)
+	if (get_var(cls[other_lit]) == get_var(cls[which_lit]))
+	  break;
+      if (other_lit > width)
+	cls[++width] = cls[which_lit];
+      else if (cls[other_lit] != cls[which_lit])
+	break; // a tautology
+    }
+  if (which_lit <= cls[0] || width <= 1)
+    {
+      if (which_lit > cls[0])
+	{
+	  if (width == 0)
+	    unsat_found = 1;
+	  else
+	    pre_add_unit(cls[1]);
+	}
+      cls_free(cls);
+      return;
+    }
+  cls[0] = width;
+  cnf_add(cls);
+  mutable_push(&(model[get_comp_lit(cls[1])].watched_lits), cls);
+  mutable_push(&(model[get_comp_lit(cls[2])].watched_lits), cls);
+}
+
+void extension_index()
+{
+  // lists the clauses of the extension stack by variable, once after
+  // preprocessing and again whenever the stack has grown
+  mutable_size_t which_clause, num_occs = 0;
+  var_set_size_t which_lit;
+  lit_t var;
+  cls_t cls;
+
+  mem_free(extension_occs);
+  mem_free(extension_starts);
+  if ((extension_starts = (mutable_size_t*)mem_calloc(MEM_EXTENSION, num_vars + 1, sizeof(mutable_size_t))) == NULL)
+    error("cannot allocate extension index");
+  for (which_clause = 0; which_clause < extension_stack.used; which_clause++)
+    {
+      cls = extension_stack.data[which_clause];
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	extension_starts[get_var(cls[which_lit]) + 1]++;
+      num_occs += cls[0];
+    }
+  for (var = 0; var < num_vars; var++)
+    extension_starts[var + 1] += extension_starts[var];
+  if ((extension_occs = (cls_t*)mem_alloc(MEM_EXTENSION, sizeof(cls_t) * (num_occs + 1))) == NULL)
+    error("cannot allocate extension index");
+
+  // move every end back to the start of its list, and fill the list forward
+  for (which_clause = extension_stack.used; which_clause > 0; which_clause--)
+    {
+      cls = extension_stack.data[which_clause - 1];
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	extension_starts[get_var(cls[which_lit]) + 1]--;
+    }
+  for (which_clause = 0; which_clause < extension_stack.used; which_clause++)
+    {
+      cls = extension_stack.data[which_clause];
+      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+	extension_occs[extension_starts[get_var(cls[which_lit]) + 1]++] = cls;
+    }
+  extension_indexed = extension_stack.used;
+}
+
+void reintroduce(lit_t var)
+{
+  // brings the eliminated variable back into the formula with the clauses of
+  // the extension stack that contain it, and in turn the eliminated variables
+  // of those clauses. witnesses of reintroduced variables are dropped. the
+  // clauses are found through the extension index, so the cost is that of the
+  // reintroduced clauses rather than of the whole stack
+  lit_t* pending;
+  mutable_size_t num_pending = 0, max_pending = 16, which_occ;
+  var_set_size_t which_lit;
+  lit_t pending_var, other_var;
+  cls_t cls;
+
+  if (extension_starts == NULL || extension_indexed != extension_stack.used)
+    extension_index();
+  if ((pending = (lit_t*)mem_alloc(MEM_EXTENSION, sizeof(lit_t) * max_pending)) == NULL)
+    error("cannot allocate reintroduction");
+  eliminated[var] = 0;
+  pending[num_pending++] = var;
+  while (num_pending > 0)
+    {
+      pending_var = pending[--num_pending];
+      for (which_occ = extension_starts[pending_var];
+	   which_occ < extension_starts[pending_var + 1]; which_occ++)
+	{
+	  cls = extension_occs[which_occ];
+	  if (cls[0] > 1)
+	    {
+	      for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+		{
+		  other_var = get_var(cls[which_lit]);
+		  if (!eliminated[other_var])
+		    continue;
+		  eliminated[other_var] = 0;
+		  if (num_pending == max_pending)
+		    {
+		      max_pending *= 2;
+		      if ((pending = (lit_t*)mem_realloc(pending, sizeof(lit_t) * max_pending)) == NULL)
+			error("cannot allocate reintroduction");
+		    }
+		  pending[num_pending++] = other_var;
+		}
+	      incremental_add(cls_copy(cls, MEM_CLAUSES));
+	    }
+	  cls[0] = 0;
+	}
+    }
+  mem_free(pending);
+}
+
+// BOUNDED MODEL CHECKING RELATED FUNCTIONS
+
+// the circuit is unrolled into a single incremental solver, one frame per
+// bound, so that the clauses learned at one bound are kept for the next.
+// solver variable 1 is the constant true, and frame k holds the variables
+// 2 + k(M + 1) to 1 + (k + 1)(M + 1): the activation literal of its bad state
+// clause, then AIGER variables 1 to M. the solver grows as the frames are
+// added, to twice the frames needed so far, and the variables beyond the
+// current bound stay eliminated, which keeps them out of the decisions
+
+void aiger_line(FILE* input, unsigned long* values, int min, int max, int* count)
+{
+  // reads a line of between min and max numbers, with their count in `count'
+  char line[256];
+
+  if (fgets(line, sizeof(line), input) == NULL)
+    error("bad aiger - unexpected end of file");
+  *count = sscanf(line, "%lu %lu %lu", values, values + 1, values + 2);
+  if (*count < min || *count > max)
+    error("bad aiger - malformed line");
+}
+
+unsigned long aiger_number(FILE* input)
+{
+  // reads a number in the variable length encoding of binary AIGER
+  unsigned long value = 0;
+  int ch, shift = 0;
+
+  do
+    {
+      if ((ch = fgetc(input)) == EOF)
+	error("bad aiger - unexpected end of file");
+      value |= (unsigned long)(ch & 0x7f) << shift;
+      shift += 7;
+    }
+  while (ch & 0x80);
+  return value;
+}
+
+void aiger_read(aiger_t* aig, char* filename)
+{
+  // reads an ASCII or binary AIGER file. symbols and comments are ignored
+  FILE* input;
+  char line[256], format[4];
+  unsigned long header[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+  unsigned long values[4], which, num_bad, lhs;
+  int num_fields, count;
+  char binary;
+
+  if ((input = fopen(filename, "rb")) == NULL)
+    error("cannot open file");
+  if (fgets(line, sizeof(line), input) == NULL)
+    error("bad aiger - header not found");
+  num_fields = sscanf(line, "%3s %lu %lu %lu %lu %lu %lu %lu %lu %lu", format,
+		      header, header + 1, header + 2, header + 3, header + 4,
+		      header + 5, header + 6, header + 7, header + 8);
+  if (num_fields < 6 || (strcmp(format, "aag") != 0 && strcmp(format, "aig") != 0))
+    error("bad aiger - header not found");
+  binary = format[1] == 'i';
+  aig->max_var = header[0];
+  aig->num_inputs = header[1];
+  aig->num_latches = header[2];
+  aig->num_ands = header[4];
+  num_bad = header[5];
+  aig->num_constraints = header[6];
+  if (header[7] > 0 || header[8] > 0)
+    error("bad aiger - justice and fairness properties are not supported");
+  if (header[3] + num_bad == 0)
+    error("bad aiger - no property");
+
+  if ((aig->inputs = (unsigned long*)mem_alloc(MEM_OTHER, sizeof(unsigned long) * (aig->num_inputs + 1))) == NULL ||
+      (aig->latches = (unsigned long*)mem_alloc(MEM_OTHER, sizeof(unsigned long) * 3 * (aig->num_latches + 1))) == NULL ||
+      (aig->ands = (unsigned long*)mem_alloc(MEM_OTHER, sizeof(unsigned long) * 3 * (aig->num_ands + 1))) == NULL ||
+      (aig->constraints = (unsigned long*)mem_alloc(MEM_OTHER, sizeof(unsigned long) * (aig->num_constraints + 1))) == NULL)
+    error("cannot allocate circuit");
+
+  // in binary files the inputs, latches and gates take the variables in order
+  for (which = 0; which < aig->num_inputs; which++)
+    {
+      if (binary)
+	aig->inputs[which] = 2 * (which + 1);
+      else
+	{
+	  aiger_line(input, values, 1, 1, &count);
+	  aig->inputs[which] = values[0];
+	}
+    }
+  for (which = 0; which < aig->num_latches; which++)
+    {
+      // a latch without a reset value starts at 0
+      if (binary)
+	{
+	  aiger_line(input, values + 1, 1, 2, &count);
+	  values[0] = 2 * (aig->num_inputs + which + 1);
+	  count++;
+	}
+      else
+	aiger_line(input, values, 2, 3, &count);
+      aig->latches[3 * which] = values[0];
+      aig->latches[3 * which + 1] = values[1];
+      aig->latches[3 * which + 2] = count == 3 ? values[2] : 0;
+    }
+  // the first bad state literal is the property, or the first output if
+  // there is none
+  for (which = 0; which < header[3]; which++)
+    {
+      aiger_line(input, values, 1, 1, &count);
+      if (which == 0 && num_bad == 0)
+	aig->bad = values[0];
+    }
+  for (which = 0; which < num_bad; which++)
+    {
+      aiger_line(input, values, 1, 1, &count);
+      if (which == 0)
+	aig->bad = values[0];
+    }
+  for (which = 0; which < aig->num_constraints; which++)
+    {
+      aiger_line(input, values, 1, 1, &count);
+      aig->constraints[which] = values[0];
+    }
+  for (which = 0; which < aig->num_ands; which++)
+    {
+      if (binary)
+	{
+	  lhs = 2 * (aig->num_inputs + aig->num_latches + which + 1);
+	  values[0] = lhs;
+	  values[1] = lhs - aiger_number(input);
+	  values[2] = values[1] - aiger_number(input);
+	}
+      else
+	aiger_line(input, values, 3, 3, &count);
+      aig->ands[3 * which] = values[0];
+      aig->ands[3 * which + 1] = values[1];
+      aig->ands[3 * which + 2] = values[2];
+    }
+  fclose(input);
+}
+
+void aiger_free(aiger_t* aig)
+{
+  mem_free(aig->inputs);
+  mem_free(aig->latches);
+  mem_free(aig->ands);
+  mem_free(aig->constraints);
+}
+
+DIMACS_lit_t bmc_lit(aiger_t* aig, unsigned long frame, unsigned long lit)
+{
+  // the DIMACS literal of the AIGER literal in the frame, where the constants
+  // are solver variable 1
+  DIMACS_lit_t var = 1;
+
+  if (lit >= 2)
+    var = 2 + frame * (aig->max_var + 1) + (lit >> 1);
+  return (lit & 1) == (lit < 2) ? var : -var;
+}
+
+DIMACS_lit_t bmc_activation(aiger_t* aig, unsigned long frame)
+{
+  return 2 + frame * (aig->max_var + 1);
+}
+
+void bmc_add(DIMACS_lit_t* lits, var_set_size_t width)
+{
+  // adds the clause of the DIMACS literals at level 0
+  var_set_size_t which_lit;
+  cls_t cls;
+
+  cls = cls_init(width, MEM_CLAUSES);
+  for (which_lit = 0; which_lit < width; which_lit++)
+    cls[which_lit + 1] = DIMACS_to_lit(lits[which_lit]);
+  incremental_add(cls);
+}
+
+void bmc_frame(aiger_t* aig, unsigned long frame, unsigned long max_bound)
+{
+  // adds the frame to the unrolling: its gates, the initial state in frame 0
+  // and the transition from the previous frame otherwise, its constraints, and
+  // its bad state clause guarded by its activation literal
+  DIMACS_lit_t lits[3];
+  unsigned long which, *gate, *latch;
+  lit_t var, end;
+
+  incremental_reset();
+  end = (lit_t)bmc_activation(aig, frame + 1) - 1;
+  if (end > num_vars)
+    {
+      var = num_vars;
+      incremental_grow(bmc_activation(aig, 2 * frame + 1 > max_bound ?
+					 max_bound + 1 : 2 * frame + 1) - 1);
+      for (; var < num_vars; var++)
+	eliminated[var] = 1;
+    }
+  for (var = bmc_activation(aig, frame) - 1; var < end; var++)
+    eliminated[var] = 0;
+
+  for (which = 0; which < aig->num_ands; which++)
+    {
+      gate = aig->ands + 3 * which;
+      lits[0] = -bmc_lit(aig, frame, gate[0]);
+      lits[1] = bmc_lit(aig, frame, gate[1]);
+      bmc_add(lits, 2);
+      lits[1] = bmc_lit(aig, frame, gate[2]);
+      bmc_add(lits, 2);
+      lits[0] = -lits[0];
+      lits[1] = -bmc_lit(aig, frame, gate[1]);
+      lits[2] = -bmc_lit(aig, frame, gate[2]);
+      bmc_add(lits, 3);
+    }
+  // a latch whose reset value is its own literal is uninitialised
+  for (which = 0; which < aig->num_latches; which++)
+    {
+      latch = aig->latches + 3 * which;
+      lits[0] = bmc_lit(aig, frame, latch[0]);
+      if (frame > 0)
+	{
+	  lits[1] = -bmc_lit(aig, frame - 1, latch[1]);
+	  bmc_add(lits, 2);
+	  lits[0] = -lits[0];
+	  lits[1] = -lits[1];
+	  bmc_add(lits, 2);
+	}
+      else if (latch[2] < 2)
+	{
+	  lits[0] = latch[2] ? lits[0] : -lits[0];
+	  bmc_add(lits, 1);
+	}
+    }
+  for (which = 0; which < aig->num_constraints; which++)
+    {
+      lits[0] = bmc_lit(aig, frame, aig->constraints[which]);
+      bmc_add(lits, 1);
+    }
+  lits[0] = -bmc_activation(aig, frame);
+  lits[1] = bmc_lit(aig, frame, aig->bad);
+  bmc_add(lits, 2);
+}
+
+void bmc_witness(aiger_t* aig, unsigned long frame)
+{
+  // prints the counterexample of the model in the AIGER witness format: the
+  // initial values of the latches, then the inputs of each frame
+  unsigned long which, which_frame;
+
+  printf("1\nb0\n");
+  for (which = 0; which < aig->num_latches; which++)
+    putchar(CDCL_value(bmc_lit(aig, 0, aig->latches[3 * which])) > 0 ? '1' : '0');
+  putchar('\n');
+  for (which_frame = 0; which_frame <= frame; which_frame++)
+    {
+      for (which = 0; which < aig->num_inputs; which++)
+	putchar(CDCL_value(bmc_lit(aig, which_frame, aig->inputs[which])) > 0 ? '1' : '0');
+      putchar('\n');
+    }
+  printf(".\n");
+}
+
+// RESULT CACHE RELATED FUNCTIONS
+
+uint64_t hash_mix(uint64_t value)
+{
+  // the splitmix64 finaliser, so that sums of mixed values do not cancel
+  value += 0x9e3779b97f4a7c15ULL;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+void cache_path(char* path, const char* suffix)
+{
+  // writes the path of the cache file of the formula
+  sprintf(path, "%s/%016llx%s", cache_dir, (unsigned long long)formula_hash, suffix);
+}
+
+void cache_evict()
+{
+  // removes the least recently used files until the cache is within its
+  // limits. only the files named after a hash are counted
+  DIR* dir;
+  struct dirent* entry;
+  struct stat info;
+  char path[PATH_MAX], oldest[PATH_MAX];
+  time_t oldest_time;
+  unsigned long num_entries, num_bytes;
+
+  if (cache_max_entries == 0 && cache_max_bytes == 0)
+    return;
+  for (;;)
+    {
+      if ((dir = opendir(cache_dir)) == NULL)
+	return;
+      num_entries = num_bytes = 0;
+      oldest[0] = '\0';
+      oldest_time = 0;
+      while ((entry = readdir(dir)) != NULL)
+	{
+	  if (strlen(entry->d_name) != CACHE_NAME_LENGTH ||
+	      strspn(entry->d_name, "0123456789abcdef") != CACHE_NAME_LENGTH)
+	    continue;
+	  snprintf(path, PATH_MAX, "%s/%s", cache_dir, entry->d_name);
+	  if (stat(path, &info) != 0)
+	    continue;
+	  num_entries++;
+	  num_bytes += info.st_size;
+	  if (oldest[0] == '\0' || info.st_mtime < oldest_time)
+	    {
+	      strcpy(oldest, path);
+	      oldest_time = info.st_mtime;
+	    }
+	}
+      closedir(dir);
+      if ((cache_max_entries == 0 || num_entries <= cache_max_entries) &&
+	  (cache_max_bytes == 0 || num_bytes <= cache_max_bytes))
+	return;
+      if (unlink(oldest) != 0)
+	return;
+    }
+}
+
+void cache_store(result_t result)
+{
+  // writes the result, and the model if it is SAT or the proof written with
+  // it if it is UNSAT, to a temporary file that is renamed into place, so
+  // that concurrent solvers never read a partial entry. the proof is named
+  // rather than copied, with its size and time so that a changed file is not
+  // trusted. a formula answered from the cache is not stored again
+  char path[PATH_MAX], temp_path[PATH_MAX], suffix[32];
+  struct stat info;
+  lit_t var;
+  FILE* output;
+
+  if (cache_dir == NULL || strcmp(cache_status, "hit") == 0)
+    return;
+  if (result == UNSAT && proof_file != NULL &&
+      (fflush(proof_file) != 0 || proof_path[0] == '\0' || stat(proof_path, &info) != 0))
+    return;
+  sprintf(suffix, ".%ld.tmp", (long)getpid());
+  cache_path(temp_path, suffix);
+  cache_path(path, "");
+  if ((output = fopen(temp_path, "w")) == NULL)
+    return;
+  fprintf(output, "%s %lu %lu\n", result == SAT ? "SAT" : "UNSAT", num_vars,
+	  num_input_clauses);
+  if (result == SAT)
+    {
+      for (var = 0; var < num_vars; var++)
+	fprintf(output, "%ld ", lit_value(var) == POSITIVE ?
+		(long)var + 1 : -(long)var - 1);
+      fprintf(output, "0\n");
+    }
+  else if (proof_file != NULL)
+    fprintf(output, "proof %lld %lld %s\n", (long long)info.st_size,
+	    (long long)info.st_mtime, proof_path);
+  if (fclose(output) != 0 || rename(temp_path, path) != 0)
+    {
+      unlink(temp_path);
+      return;
+    }
+  cache_status = "stored";
+  cache_evict();
+}
+
+char cache_proof(FILE* input)
+{
+  // copies the proof named by an UNSAT entry into the proof being written,
+  // unless the file is gone or was changed since the entry was stored
+  char path[PATH_MAX], buffer[1 << 16];
+  long long size, mtime;
+  struct stat info;
+  size_t length;
+  FILE* proof;
+
+  if (fscanf(input, " proof %lld %lld ", &size, &mtime) != 2 ||
+      fgets(path, PATH_MAX, input) == NULL)
+    return 0;
+  path[strcspn(path, "\n")] = '\0';
+  if (strcmp(path, proof_path) == 0 || stat(path, &info) != 0 ||
+      (long long)info.st_size != size || (long long)info.st_mtime != mtime ||
+      (proof = fopen(path, "r")) == NULL)
+    return 0;
+  while ((length = fread(buffer, 1, sizeof(buffer), proof)) > 0)
+    fwrite(buffer, 1, length, proof_file);
+  fclose(proof);
+  return fflush(proof_file) == 0;
+}
+
+result_t cache_lookup()
+{
+  // reads the cached result of the formula. a cached model is decided on
+  // level 1 and must satisfy every clause, so a hash collision or a corrupt
+  // file is caught and the entry dropped. when a proof is written, an UNSAT
+  // entry is a hit only with a proof to copy, and is kept otherwise
+  char path[PATH_MAX], result[8];
+  var_set_size_t cached_vars;
+  cnf_size_t cached_clauses, which_clause;
+  DIMACS_lit_t DIMACS_lit;
+  ass_t** head = trail.head;
+  char valid;
+  FILE* input;
+
+  cache_path(path, "");
+  if ((input = fopen(path, "r")) == NULL)
+    return UNKNOWN;
+  valid = fscanf(input, "%7s %lu %lu", result, &cached_vars, &cached_clauses) == 3 &&
+    cached_vars == num_vars && cached_clauses == num_input_clauses &&
+    (strcmp(result, "SAT") == 0 || strcmp(result, "UNSAT") == 0);
+  if (valid && strcmp(result, "SAT") == 0)
+    {
+      dec_level++;
+      while (valid && fscanf(input, "%ld", &DIMACS_lit) == 1 && DIMACS_lit != 0)
+	{
+	  if (labs(DIMACS_lit) > (long)num_vars ||
+	      lit_value(DIMACS_to_lit(DIMACS_lit)) == NEGATIVE)
+	    valid = 0;
+	  else if (lit_value(DIMACS_to_lit(DIMACS_lit)) == UNASSIGNED)
+	    trail_add_lit(DIMACS_to_lit(DIMACS_lit), DEC_ASS, NULL);
+	}
+      for (which_clause = 0; valid && which_clause < cnf.size; which_clause++)
+	valid = cls_is_satisfied(cnf.clauses[which_clause]);
+      if (!valid)
+	{
+	  backtrack(0);
+	  trail.head = head;
+	}
+    }
+  else if (valid && proof_file != NULL && !cache_proof(input))
+    {
+      fclose(input);
+      return UNKNOWN;
+    }
+  fclose(input);
+  if (!valid)
+    {
+      unlink(path);
+      return UNKNOWN;
+    }
+  // mark the entry as recently used
+  utime(path, NULL);
+  return strcmp(result, "SAT") == 0 ? SAT : UNSAT;
+}
+
+// PROOF TRIMMING RELATED FUNCTIONS
+
+// an LRAT proof is trimmed by reading it backwards from the empty clause,
+// marking the clauses each needed clause names in its hints. the memory used
+// is two bits per clause id, and the longest line. needed lines are written
+// to a temporary file in reverse and reversed again into the trimmed proof,
+// with each clause deleted right after the last line that names it. a DRAT
+// proof, such as those written with -d, is first checked forwards into a
+// temporary LRAT proof
+
+typedef struct backward_reader {
+  FILE* file;
+  long offset; // file offset of the first byte of the buffer
+  char* buffer;
+  size_t used; // bytes of the buffer not yet returned
+  size_t capacity;
+} backward_reader_t;
+
+void backward_init(backward_reader_t* reader, FILE* file)
+{
+  reader->file = file;
+  if (fseek(file, 0, SEEK_END) != 0 || (reader->offset = ftell(file)) < 0)
+    error("cannot seek in proof");
+  reader->used = 0;
+  reader->capacity = TRIM_BLOCK + 1;
+  if ((reader->buffer = (char*)mem_alloc(MEM_OTHER, reader->capacity)) == NULL)
+    error("cannot allocate proof buffer");
+}
+
+char* backward_line(backward_reader_t* reader)
+{
+  // returns the previous line of the file without its newline, or NULL once
+  // the start of the file is reached. the line stays valid until the next call
+  size_t start, block;
+  char* line;
+
+  if (reader->used == 0 && reader->offset == 0)
+    return NULL;
+  for (;;)
+    {
+      for (start = reader->used; start > 0 && reader->buffer[start - 1] != '\n'; start--)
+	continue;
+      if (start > 0 || reader->offset == 0)
+	break;
+      // the line starts before the buffer, so read the block in front of it
+      block = reader->offset < TRIM_BLOCK ? reader->offset : TRIM_BLOCK;
+      if (reader->used + block + 1 > reader->capacity)
+	{
+	  reader->capacity = 2 * (reader->used + block + 1);
+	  if ((reader->buffer = (char*)mem_realloc(reader->buffer, reader->capacity)) == NULL)
+	    error("cannot reallocate proof buffer");
+	}
+      memmove(reader->buffer + block, reader->buffer, reader->used);
+      reader->offset -= block;
+      if (fseek(reader->file, reader->offset, SEEK_SET) != 0 ||
+	  fread(reader->buffer, 1, block, reader->file) != block)
+	error("cannot read proof");
+      reader->used += block;
+    }
+  line = reader->buffer + start;
+  reader->buffer[reader->used] = '\0';
+  reader->used = start > 0 ? start - 1 : 0;
+  return line;
+}
+
+char bit_test(unsigned char* bits, unsigned long index)
+{
+  return (bits[index >> 3] >> (index & 7)) & 1;
+}
+
+void bit_set(unsigned char* bits, unsigned long index)
+{
+  bits[index >> 3] |= 1 << (index & 7);
+}
+
+char* trim_parse(char* cursor, long* value)
+{
+  // reads the next number of a proof line, or returns NULL if there is none
+  char* end;
+
+  *value = strtol(cursor, &end, 10);
+  return end == cursor ? NULL : end;
+}
+
+char trim_is_drat(FILE* proof)
+{
+  // tells a DRAT proof from an LRAT one by its first line: a DRAT line has
+  // one 0 and may start with d, while an LRAT line starts with its id and has
+  // d second or two 0s
+  int ch, num_zeros = 0, num_tokens = 0;
+  char token[32];
+
+  while ((ch = fgetc(proof)) == 'c' || ch == '\n' || ch == '\r')
+    while (ch == 'c' && (ch = fgetc(proof)) != '\n' && ch != EOF)
+      continue;
+  while (ch != '\n' && ch != EOF)
+    {
+      if (ch == ' ' || ch == '\t' || ch == '\r')
+	{
+	  ch = fgetc(proof);
+	  continue;
+	}
+      ungetc(ch, proof);
+      if (fscanf(proof, "%31[^ \t\r\n]", token) != 1)
+	break;
+      if (strcmp(token, "d") == 0)
+	{
+	  rewind(proof);
+	  return num_tokens == 0;
+	}
+      num_zeros += strcmp(token, "0") == 0;
+      num_tokens++;
+      ch = fgetc(proof);
+    }
+  rewind(proof);
+  return num_zeros == 1;
+}
+
+void trim_write_core(char* DIMACS_filename, char* core_filename,
+		     unsigned char* needed, unsigned long max_id)
+{
+  // copies the clauses of the formula whose ids are marked to the core, and
+  // prints their indices in the formula, counted from 1
+  FILE* input, *output;
+  unsigned long num_clauses, which_clause, core_size = 0;
+  long num_file_vars, DIMACS_lit;
+  int ch;
+
+  if ((input = fopen(DIMACS_filename, "r")) == NULL)
+    error("cannot open file");
+  while ((ch = fgetc(input)) == 'c')
+    while ((ch = fgetc(input)) != '\n' && ch != EOF)
+      continue;
+  if (ch != 'p' || fscanf(input, " cnf %ld %lu", &num_file_vars, &num_clauses) != 2)
+    error("bad input - header not found");
+  for (which_clause = 1; which_clause <= num_clauses && which_clause <= max_id; which_clause++)
+    core_size += bit_test(needed, which_clause);
+  if ((output = fopen(core_filename, "w")) == NULL)
+    error("cannot open core");
+  fprintf(output, "p cnf %ld %lu\n", num_file_vars, core_size);
+  for (which_clause = 1; which_clause <= num_clauses; which_clause++)
+    {
+      ch = which_clause <= max_id && bit_test(needed, which_clause);
+      if (ch)
+	printf("%lu\n", which_clause);
+      do
+	{
+	  if (fscanf(input, "%ld", &DIMACS_lit) != 1)
+	    error("bad input - clause missing");
+	  if (ch)
+	    fprintf(output, DIMACS_lit ? "%ld " : "%ld\n", DIMACS_lit);
+	}
+      while (DIMACS_lit != 0);
+    }
+  fclose(input);
+  if (fclose(output) != 0)
+    error("cannot write core");
+  fprintf(stderr, "Core:              %lu of %lu clauses\n", core_size, num_clauses);
+}
+
+// PROOF CHECKING RELATED FUNCTIONS
+
+// a DRAT proof without RAT steps is checked forwards: every clause it adds
+// must be implied by unit propagation on the formula and the clauses added
+// before it and not deleted. the assignment at the top level only grows, so a
+// deleted unit keeps its literal assigned, as with drat-trim
+
+lit_t check_lit(DIMACS_lit_t DIMACS_lit)
+{
+  // converts a DIMACS literal into a literal of the checker
+  return 2 * (lit_t)(labs(DIMACS_lit) - 1) + (DIMACS_lit < 0);
+}
+
+char check_read(FILE* file, char* deletion)
+{
+  // reads the next clause into check_lits without duplicate literals, which
+  // are stamped, and notes whether it is a tautology and whether it is
+  // deleted. returns 0 at the end of the file
+  DIMACS_lit_t DIMACS_lit;
+  lit_t lit;
+  int ch;
+
+  *deletion = 0;
+  check_width = 0;
+  check_tautology = 0;
+  check_stamp++;
+  for (;;)
+    {
+      while ((ch = fgetc(file)) == ' ' || ch == '\t' || ch == '\n' || ch == '\r')
+	continue;
+      if (ch == EOF)
+	{
+	  if (check_width > 0 || *deletion)
+	    error("bad clause - not terminated");
+	  return 0;
+	}
+      if (ch == 'c')
+	{
+	  while ((ch = fgetc(file)) != '\n' && ch != EOF)
+	    continue;
+	  continue;
+	}
+      if (ch == 'd')
+	{
+	  *deletion = 1;
+	  continue;
+	}
+      ungetc(ch, file);
+      if (fscanf(file, "%ld", &DIMACS_lit) != 1)
+	error("bad clause - literal expected");
+      if (DIMACS_lit == 0)
+	return 1;
+      if (labs(DIMACS_lit) > (long)check_num_vars)
+	error("bad clause - variable out of range");
+      lit = check_lit(DIMACS_lit);
+      if (check_stamps[lit ^ 1] == check_stamp)
+	check_tautology = 1;
+      if (check_stamps[lit] == check_stamp)
+	continue;
+      check_stamps[lit] = check_stamp;
+      check_lits[check_width++] = lit;
+    }
+}
+
+void check_assign(lit_t lit, cls_t reason, unsigned long reason_id)
+{
+  check_values[lit] = 1;
+  check_values[lit ^ 1] = -1;
+  check_trail[check_trail_size++] = lit;
+  if (check_lrat != NULL)
+    {
+      check_reasons[lit >> 1] = reason;
+      check_reason_ids[lit >> 1] = reason_id;
+      check_positions[lit >> 1] = check_trail_size - 1;
+    }
+}
+
+unsigned long check_cls_id(cls_t cls)
+{
+  return (unsigned long)cls[cls[0] + 1];
+}
+
+void check_mark(lit_t* lits, var_set_size_t width, var_set_size_t* num_marked)
+{
+  var_set_size_t which_lit;
+
+  for (which_lit = 0; which_lit < width; which_lit++)
+    if (!check_marks[lits[which_lit] >> 1])
+      {
+	check_marks[lits[which_lit] >> 1] = 1;
+	(*num_marked)++;
+      }
+}
+
+void check_chain(char negated, var_set_size_t num_marked)
+{
+  // collects into check_hints, in trail order, the reasons of the marked
+  // variables and in turn of the variables of those reasons. the complements
+  // of the literals of the clause read last are left out if it is negated
+  lit_t which_entry = check_trail_size, lit;
+  cls_t reason;
+
+  check_num_hints = 0;
+  while (num_marked > 0 && which_entry > 0)
+    {
+      lit = check_trail[--which_entry];
+      if (!check_marks[lit >> 1])
+	continue;
+      if (!negated || check_stamps[lit ^ 1] != check_stamp)
+	{
+	  check_hints[check_num_hints++] = check_reason_ids[lit >> 1];
+	  if ((reason = check_reasons[lit >> 1]) != NULL)
+	    check_mark(reason + 1, reason[0], &num_marked);
+	}
+      // the reason holds the variable itself, already marked
+      check_marks[lit >> 1] = 0;
+      num_marked--;
+    }
+}
+
+void check_write(lit_t* lits, var_set_size_t width, unsigned long id, unsigned long conflict_id)
+{
+  // writes an LRAT line, with the hints of check_chain and the conflict last
+  var_set_size_t which;
+
+  fprintf(check_lrat, "%lu", id);
+  for (which = 0; which < width; which++)
+    fprintf(check_lrat, " %ld", (lits[which] & 1) ? -(long)(lits[which] >> 1) - 1 :
+	    (long)(lits[which] >> 1) + 1);
+  fprintf(check_lrat, " 0");
+  for (which = check_num_hints; which > 0; which--)
+    fprintf(check_lrat, " %lu", check_hints[which - 1]);
+  if (conflict_id != 0)
+    fprintf(check_lrat, " %lu", conflict_id);
+  fprintf(check_lrat, " 0\n");
+}
+
+void check_refute(cls_t conflict, unsigned long conflict_id)
+{
+  // writes the empty clause, from the conflict of the given clause at the top
+  // level, or of the clause read last if NULL
+  var_set_size_t num_marked = 0;
+
+  if (check_lrat == NULL)
+    return;
+  if (conflict != NULL)
+    check_mark(conflict + 1, conflict[0], &num_marked);
+  else
+    check_mark(check_lits, check_width, &num_marked);
+  check_chain(0, num_marked);
+  check_write(NULL, 0, ++check_last_id, conflict_id);
+}
+
+char check_propagate()
+{
+  // propagates the assignments on the trail from check_head, and returns 1 on
+  // conflict
+  mutable_t* watches;
+  mutable_size_t which_clause, kept;
+  var_set_size_t which_lit;
+  lit_t false_lit;
+  cls_t cls;
+
+  while (check_head < check_trail_size)
+    {
+      watches = check_watches + check_trail[check_head];
+      false_lit = check_trail[check_head++] ^ 1;
+      kept = 0;
+      for (which_clause = 0; which_clause < watches->used; which_clause++)
+	{
+	  // keep the false watch second
+	  cls = watches->data[which_clause];
+	  if (cls[1] == false_lit)
+	    {
+	      cls[1] = cls[2];
+	      cls[2] = false_lit;
+	    }
+	  if (check_values[cls[1]] == 1)
+	    {
+	      watches->data[kept++] = cls;
+	      continue;
+	    }
+	  for (which_lit = 3; which_lit <= cls[0] &&
+		 check_values[cls[which_lit]] == -1; which_lit++)
+	    continue;
+	  if (which_lit <= cls[0])
+	    {
+	      cls[2] = cls[which_lit];
+	      cls[which_lit] = false_lit;
+	      mutable_push(check_watches + (cls[2] ^ 1), cls);
+	      continue;
+	    }
+	  watches->data[kept++] = cls;
+	  if (check_values[cls[1]] == -1)
+	    {
+	      for (which_clause++; which_clause < watches->used; which_clause++)
+		watches->data[kept++] = watches->data[which_clause];
+	      watches->used = kept;
+	      check_conflict = cls;
+	      return 1;
+	    }
+	  check_assign(cls[1], cls, check_cls_id(cls));
+	}
+      watches->used = kept;
+    }
+  return 0;
+}
+
+uint64_t check_hash(lit_t* lits, var_set_size_t width)
+{
+  // hashes the literals independently of their order
+  uint64_t hash = width;
+  var_set_size_t which_lit;
+
+  for (which_lit = 0; which_lit < width; which_lit++)
+    hash += hash_mix(lits[which_lit] + 1);
+  return hash;
+}
+
+void check_rehash()
+{
+  // doubles the number of buckets
+  mutable_t* buckets = check_buckets;
+  mutable_size_t num_buckets = check_num_buckets, which_bucket, which_clause;
+  cls_t cls;
+
+  check_num_buckets *= 2;
+  if ((check_buckets = (mutable_t*)mem_alloc(MEM_OTHER, sizeof(mutable_t) * check_num_buckets)) == NULL)
+    error("cannot allocate clause hash");
+  for (which_bucket = 0; which_bucket < check_num_buckets; which_bucket++)
+    mutable_init(check_buckets + which_bucket, MEM_OTHER);
+  for (which_bucket = 0; which_bucket < num_buckets; which_bucket++)
+    {
+      for (which_clause = 0; which_clause < buckets[which_bucket].used; which_clause++)
+	{
+	  cls = buckets[which_bucket].data[which_clause];
+	  mutable_push(check_buckets + (check_hash(cls + 1, cls[0]) & (check_num_buckets - 1)),
+		       cls);
+	}
+      mutable_free(buckets + which_bucket);
+    }
+  mem_free(buckets);
+}
+
+char check_rup()
+{
+  // returns 1 if the clause read last is implied by unit propagation: if it is
+  // satisfied, or if assigning its literals false leads to a conflict. when
+  // writing LRAT, its hints are left in check_hints and the conflicting
+  // clause in check_conflict, NULL if it is satisfied. the hints of a
+  // satisfied clause derive its literal assigned first, whose reasons cannot
+  // hold the complement of another of its literals
+  var_set_size_t which_lit, num_marked = 0;
+  lit_t top = check_trail_size, lit, true_lit = 0;
+  char implied = check_refuted || check_tautology;
+
+  for (which_lit = 0; which_lit < check_width && !implied; which_lit++)
+    if (check_values[check_lits[which_lit]] == 1)
+      {
+	lit = check_lits[which_lit];
+	if (true_lit == 0 ||
+	    check_positions[lit >> 1] < check_positions[(true_lit - 1) >> 1])
+	  true_lit = lit + 1;
+	implied = check_lrat == NULL;
+      }
+  if (true_lit != 0)
+    {
+      implied = 1;
+      lit = true_lit - 1;
+      check_mark(&lit, 1, &num_marked);
+      check_chain(1, num_marked);
+      check_conflict = NULL;
+    }
+  for (which_lit = 0; which_lit < check_width && !implied; which_lit++)
+    if (check_values[check_lits[which_lit]] == 0)
+      check_assign(check_lits[which_lit] ^ 1, NULL, 0);
+  if (!implied && (implied = check_propagate()) && check_lrat != NULL)
+    {
+      check_mark(check_conflict + 1, check_conflict[0], &num_marked);
+      check_chain(1, num_marked);
+    }
+  while (check_trail_size > top)
+    {
+      lit = check_trail[--check_trail_size];
+      check_values[lit] = 0;
+      check_values[lit ^ 1] = 0;
+    }
+  check_head = top;
+  return implied;
+}
+
+void check_add()
+{
+  // adds the clause read last at the top level. a clause whose literals are
+  // all false refutes the formula, and one with a single literal that is not
+  // false assigns it. clauses of two or more literals are watched and hashed,
+  // with their literals that are not false first
+  var_set_size_t which_lit, num_open = 0;
+  lit_t temp_lit;
+  cls_t cls = NULL;
+
+  if (check_tautology || check_refuted)
+    return;
+  for (which_lit = 0; which_lit < check_width; which_lit++)
+    if (check_values[check_lits[which_lit]] != -1)
+      {
+	temp_lit = check_lits[num_open];
+	check_lits[num_open++] = check_lits[which_lit];
+	check_lits[which_lit] = temp_lit;
+      }
+  if (check_width >= 2)
+    {
+      cls = cls_init(check_width + 1, MEM_OTHER);
+      cls[0] = check_width;
+      cls[check_width + 1] = check_id;
+      for (which_lit = 0; which_lit < check_width; which_lit++)
+	cls[which_lit + 1] = check_lits[which_lit];
+      mutable_push(check_watches + (cls[1] ^ 1), cls);
+      mutable_push(check_watches + (cls[2] ^ 1), cls);
+      mutable_push(check_buckets + (check_hash(cls + 1, cls[0]) & (check_num_buckets - 1)),
+		   cls);
+      if (++check_num_clauses > check_num_buckets)
+	check_rehash();
+    }
+  if (num_open == 0)
+    {
+      check_refuted = 1;
+      check_refute(NULL, check_id);
+    }
+  else if (num_open == 1 && check_values[check_lits[0]] == 0)
+    {
+      check_assign(check_lits[0], check_width >= 2 ? cls : NULL, check_id);
+      if (check_propagate())
+	{
+	  check_refuted = 1;
+	  check_refute(check_conflict, check_cls_id(check_conflict));
+	}
+    }
+}
+
+void check_delete()
+{
+  // deletes a clause with the literals of the clause read last. a deletion
+  // that finds no such clause, such as that of a unit, is ignored
+  mutable_t* bucket, *watches;
+  mutable_size_t which_clause, which_watch;
+  var_set_size_t which_lit, side;
+  cls_t cls = NULL;
+
+  if (check_width < 2 || check_tautology)
+    return;
+  bucket = check_buckets + (check_hash(check_lits, check_width) & (check_num_buckets - 1));
+  for (which_clause = 0; which_clause < bucket->used; which_clause++)
+    {
+      cls = bucket->data[which_clause];
+      if (cls[0] != check_width)
+	continue;
+      for (which_lit = 1; which_lit <= cls[0] &&
+	     check_stamps[cls[which_lit]] == check_stamp; which_lit++)
+	continue;
+      if (which_lit > cls[0])
+	break;
+    }
+  if (which_clause == bucket->used)
+    return;
+  bucket->data[which_clause] = bucket->data[--bucket->used];
+  for (side = 1; side <= 2; side++)
+    {
+      watches = check_watches + (cls[side] ^ 1);
+      for (which_watch = 0; watches->data[which_watch] != cls; which_watch++)
+	continue;
+      watches->data[which_watch] = watches->data[--watches->used];
+    }
+  check_num_clauses--;
+
+  // a reason at the top level is still named by the hints that follow
+  if (check_lrat != NULL)
+    for (which_lit = 1; which_lit <= cls[0]; which_lit++)
+      if (check_values[cls[which_lit]] == 1 && check_reasons[cls[which_lit] >> 1] == cls)
+	{
+	  mutable_push(&check_kept, cls);
+	  return;
+	}
+  cls_free(cls);
+}
+
+char check_proof(char* DIMACS_filename, char* proof_filename, FILE* lrat)
+{
+  // checks the DRAT proof of the formula, and writes it as LRAT to the given
+  // file unless NULL. returns 1 if it is verified
+  FILE* input;
+  unsigned long num_clauses, which_clause, num_added = 0, num_deleted = 0;
+  long num_file_vars;
+  lit_t which_ass;
+  mutable_size_t which_bucket;
+  char deletion, verified = 0, failed = 0;
+  int ch;
+
+  if ((input = fopen(DIMACS_filename, "r")) == NULL)
+    error("cannot open file");
+  while ((ch = fgetc(input)) == 'c')
+    while ((ch = fgetc(input)) != '\n' && ch != EOF)
+      continue;
+  if (ch != 'p' || fscanf(input, " cnf %ld %lu", &num_file_vars, &num_clauses) != 2 ||
+      num_file_vars < 0)
+    error("bad input - header not found");
+  check_num_vars = num_file_vars;
+  if ((check_values = (signed char*)mem_calloc(MEM_MODEL, 2 * check_num_vars + 2, 1)) == NULL ||
+      (check_stamps = (unsigned long*)mem_calloc(MEM_OTHER, 2 * check_num_vars + 2,
+						 sizeof(unsigned long))) == NULL ||
+      (check_trail = (lit_t*)mem_alloc(MEM_TRAIL, sizeof(lit_t) * (check_num_vars + 1))) == NULL ||
+      (check_lits = (lit_t*)mem_alloc(MEM_OTHER, sizeof(lit_t) * (2 * check_num_vars + 1))) == NULL ||
+      (check_watches = (mutable_t*)mem_alloc(MEM_WATCHES, sizeof(mutable_t) *
+					     (2 * check_num_vars + 2))) == NULL)
+    error("cannot allocate proof checker");
+  for (which_ass = 0; which_ass < 2 * check_num_vars + 2; which_ass++)
+    mutable_init(check_watches + which_ass, MEM_WATCHES);
+  check_num_buckets = 1024;
+  if ((check_buckets = (mutable_t*)mem_alloc(MEM_OTHER, sizeof(mutable_t) * check_num_buckets)) == NULL)
+    error("cannot allocate clause hash");
+  for (which_bucket = 0; which_bucket < check_num_buckets; which_bucket++)
+    mutable_init(check_buckets + which_bucket, MEM_OTHER);
+  check_num_clauses = 0;
+  check_trail_size = 0;
+  check_head = 0;
+  check_stamp = 0;
+  check_refuted = 0;
+  check_lrat = lrat;
+  check_last_id = num_clauses;
+  if (check_lrat != NULL)
+    {
+      if ((check_reasons = (cls_t*)mem_alloc(MEM_OTHER, sizeof(cls_t) * (check_num_vars + 1))) == NULL ||
+	  (check_reason_ids = (unsigned long*)mem_alloc(MEM_OTHER, sizeof(unsigned long) *
+							(check_num_vars + 1))) == NULL ||
+	  (check_positions = (lit_t*)mem_alloc(MEM_OTHER, sizeof(lit_t) * (check_num_vars + 1))) == NULL ||
+	  (check_marks = (char*)mem_calloc(MEM_OTHER, check_num_vars + 1, sizeof(char))) == NULL ||
+	  (check_hints = (unsigned long*)mem_alloc(MEM_OTHER, sizeof(unsigned long) *
+						   (check_num_vars + 1))) == NULL)
+	error("cannot allocate proof checker");
+      mutable_init(&check_kept, MEM_OTHER);
+    }
+
+  for (which_clause = 0; which_clause < num_clauses; which_clause++)
+    {
+      if (!check_read(input, &deletion) || deletion)
+	error("bad input - clause missing");
+      check_id = which_clause + 1;
+      check_add();
+    }
+  fclose(input);
+
+  // every added clause must be implied, up to the first empty one
+  if ((input = fopen(proof_filename, "r")) == NULL)
+    error("cannot open proof");
+  while (!verified && !failed && check_read(input, &deletion))
+    {
+      if (deletion)
+	{
+	  num_deleted++;
+	  check_delete();
+	  continue;
+	}
+      num_added++;
+      if (!check_refuted)
+	check_id = ++check_last_id;
+      if (!check_rup())
+	{
+	  fprintf(stderr, "Clause %lu of the proof is not implied.\n", num_added);
+	  failed = 1;
+	  continue;
+	}
+      verified = check_width == 0;
+      if (check_lrat != NULL && !check_refuted && !check_tautology)
+	check_write(check_lits, check_width, check_id,
+		    check_conflict == NULL ? 0 : check_cls_id(check_conflict));
+      check_add();
+    }
+  fclose(input);
+  if (!verified && !failed)
+    fprintf(stderr, "The proof adds no empty clause.\n");
+  fprintf(stderr, "Proof:             %lu added, %lu deleted\n", num_added, num_deleted);
+  fprintf(stderr, verified ? "v VERIFIED\n" : "v NOT VERIFIED\n");
+
+  for (which_bucket = 0; which_bucket < check_num_buckets; which_bucket++)
+    mutable_free_clauses(check_buckets + which_bucket);
+  mem_free(check_buckets);
+  for (which_ass = 0; which_ass < 2 * check_num_vars + 2; which_ass++)
+    mutable_free(check_watches + which_ass);
+  mem_free(check_watches);
+  mem_free(check_values);
+  mem_free(check_stamps);
+  mem_free(check_trail);
+  mem_free(check_lits);
+  if (check_lrat != NULL)
+    {
+      mutable_free_clauses(&check_kept);
+      mem_free(check_reasons);
+      mem_free(check_reason_ids);
+      mem_free(check_positions);
+      mem_free(check_marks);
+      mem_free(check_hints);
+      check_lrat = NULL;
+    }
+  return verified;
+}
+
+// PARALLEL PROPAGATION RELATED FUNCTIONS
+
+void par_range(int index)
+{
+  // decides the action on each clause of the index'th range of the split
+  // watch list. only the clauses of the range are written
+  cnf_size_t which_clause = par_num_clauses * index / par_num_threads;
+  cnf_size_t end = par_num_clauses * (index + 1) / par_num_threads;
+  lit_t comp_lit = get_comp_lit(par_propagator);
+  lit_t* watches, *watched_lit, *other_watched_lit;
+  var_set_size_t which_lit, width;
+  lit_t temp_lit;
+  cls_t clause;
+
+  for (; which_clause < end; which_clause++)
+    {
+      clause = par_data[which_clause];
+      width = clause[0];
+      watches = cls_watches(clause);
+      watched_lit = watches + (watches[0] == comp_lit ? 0 : 1);
+      other_watched_lit = watches + (watches[0] == comp_lit ? 1 : 0);
+      par_actions[which_clause] = PAR_UNIT;
+      if (lit_value(*other_watched_lit) == POSITIVE)
+	par_actions[which_clause] = PAR_KEEP;
+      else
+	for (which_lit = watches == clause + 1 ? 3 : 1; which_lit <= width; which_lit++)
+	  if (lit_value(clause[which_lit]) != NEGATIVE &&
+	      clause[which_lit] != *other_watched_lit)
+	    {
+	      temp_lit = clause[which_lit];
+	      if (watches == clause + 1)
+		clause[which_lit] = *watched_lit;
+	      *watched_lit = temp_lit;
+	      par_actions[which_clause] = temp_lit;
+	      break;
+	    }
+    }
+}
+
+void* par_run(void* argument)
+{
+  // a helper visits its range of each split watch list, forever
+  int index = *(int*)argument;
+
+  while (1)
+    {
+      pthread_barrier_wait(&par_start);
+      par_range(index);
+      pthread_barrier_wait(&par_done);
+    }
+  return NULL;
+}
+
+void par_start_helpers()
+{
+  // started on first use, in the process that propagates
+  int which_thread;
+
+  if (pthread_barrier_init(&par_start, NULL, par_num_threads) != 0 ||
+      pthread_barrier_init(&par_done, NULL, par_num_threads) != 0)
+    error("cannot initialise propagation helpers");
+  for (which_thread = 1; which_thread < par_num_threads; which_thread++)
+    {
+      par_indices[which_thread] = which_thread;
+      if (pthread_create(par_threads + which_thread, NULL, par_run,
+			 par_indices + which_thread) != 0)
+	error("cannot start propagation helper");
+    }
+  par_running = 1;
+}
+
+state_t par_prop_lit(lit_t propagator)
+{
+  // propagates the literal at the head of the trail as prop_lit does, with
+  // its watch list split between the threads
+  mutable_t new_watchers;
+  cnf_size_t num_clauses = model[propagator].watched_lits.used;
+  cnf_size_t which_clause;
+  lit_t* watches, *other_watched_lit;
+  lit_t action;
+  cls_t clause;
+  char conflict = 0;
+
+  if (num_clauses > par_capacity)
+    {
+      mem_free(par_actions);
+      par_capacity = 2 * num_clauses;
+      if ((par_actions = (lit_t*)mem_alloc(MEM_SEARCH, sizeof(lit_t) * par_capacity)) == NULL)
+	error("cannot allocate propagation actions");
+    }
+  if (!par_running)
+    par_start_helpers();
+  par_propagator = propagator;
+  par_data = model[propagator].watched_lits.data;
+  par_num_clauses = num_clauses;
+  pthread_barrier_wait(&par_start);
+  par_range(0);
+  pthread_barrier_wait(&par_done);
+  num_split_props++;
+
+  // a unit whose literal an earlier unit has made true needs nothing, and one
+  // whose literal is false is the conflict. the units after it are dropped
+  mutable_init(&new_watchers, MEM_WATCHES);
+  for (which_clause = 0; which_clause < num_clauses; which_clause++)
+    {
+      clause = par_data[which_clause];
+      action = par_actions[which_clause];
+      if (action != PAR_KEEP && action != PAR_UNIT)
+	{
+	  mutable_push(&(model[get_comp_lit(action)].watched_lits), clause);
+	  continue;
+	}
+      mutable_push(&new_watchers, clause);
+      if (action == PAR_KEEP || conflict)
+	continue;
+      watches = cls_watches(clause);
+      other_watched_lit = watches + (watches[0] == get_comp_lit(propagator) ? 1 : 0);
+      if (lit_value(*other_watched_lit) == POSITIVE)
+	continue;
+      num_unit_props++;
+      if (lit_value(*other_watched_lit) == NEGATIVE)
+	{
+	  conflict_cls = clause;
+	  conflict = 1;
+	}
+      else
+	trail_add_lit(*other_watched_lit, PROP_ASS, clause);
+    }
+  mutable_free(&(model[propagator].watched_lits));
+  model[propagator].watched_lits = new_watchers;
+  if (conflict)
+    return CONFLICT;
+
+  if (amo_watches != NULL && amo_prop(propagator) == CONFLICT)
+    return CONFLICT;
+  trail.head++;
+  return PROPAGATE;
+}
+
+// BATCH RELATED FUNCTIONS
+
+// a batch interleaves the search of several formulas in one thread, one
+// propagated literal or decision at a time, so that the memory accesses of one
+// formula overlap with the work on the others
+
+#define X(type, name) instance->name = name;
+void instance_save(instance_t* instance)
+{
+  INSTANCE_STATE
+}
+#undef X
+
+#define X(type, name) name = instance->name;
+void instance_load(instance_t* instance)
+{
+  INSTANCE_STATE
+}
+#undef X
+
+void instance_prefetch(instance_t* instance, instance_t* next_instance)
+{
+  // prefetches the watched clauses the instance propagates next, and the
+  // assignment whose watches the instance after it propagates next. the
+  // watches are reached through the assignment prefetched one turn earlier
+  if (instance->active && instance->trail.head != instance->trail.tail)
+    __builtin_prefetch((*instance->trail.head)->watched_lits.data);
+  if (next_instance->active && next_instance->trail.head != next_instance->trail.tail)
+    __builtin_prefetch(*next_instance->trail.head);
+}
+
+char instance_start(instance_t* instance, char* filename)
+{
+  // parses and preprocesses a formula into the instance. returns 1 if it
+  // still needs searching, 0 if it was solved on the way
+  memset(instance, 0, sizeof(instance_t));
+  instance->lucky_strategy = "none";
+  instance->filename = filename;
+  instance_load(instance);
+  if (setjmp(report_jump) != 0)
+    {
+      printf("%s: %s\n", filename, report_result == SAT ? "SAT" : "UNSAT");
+      CDCL_free();
+      return 0;
+    }
+  CDCL_init(filename);
+  CDCL_preprocess();
+  CDCL_lucky();
+  instance->active = 1;
+  instance_save(instance);
+  return 1;
+}
+
+// CDCL INTERFACE IMPLEMENTATION
+
+void  CDCL_print_stats()
+{
+  int which_feature;
+
+  fprintf(stderr, "Conflicts:         %lu\n", num_conflicts);
+  fprintf(stderr, "Decisions:         %lu\n", num_decisions);
+  fprintf(stderr, "Unit Propagations: %lu\n", num_unit_props);
+  fprintf(stderr, "Eliminated:        %lu\n", num_eliminated);
+  fprintf(stderr, "Shrunk:            %lu levels, %lu literals\n",
+	  num_shrunk_levels, num_shrunk_lits);
+  fprintf(stderr, "Bin. minimized:    %lu literals\n", num_bin_minimized_lits);
+  fprintf(stderr, "At-most-ones:      %lu\n", num_amos);
+  if (itp_filename != NULL)
+    fprintf(stderr, "Interpolant:       %lu of %lu and gates, %lu shared variables\n",
+	    itp_num_written, itp_num_nodes - itp_num_inputs - 1, itp_num_inputs);
+  if (cache_dir != NULL)
+    fprintf(stderr, "Cache:             %s, hash %016llx\n", cache_status,
+	    (unsigned long long)formula_hash);
+  if (config_distance >= 0)
+    {
+      fprintf(stderr, "Config:            %s, distance %.3f\n", config.name,
+	      config_distance);
+      fprintf(stderr, "Features:         ");
+      for (which_feature = 0; which_feature < NUM_FEATURES; which_feature++)
+	fprintf(stderr, " %s %.3f", feature_names[which_feature], features[which_feature]);
+      fprintf(stderr, "\n");
+    }
+  fprintf(stderr, "Lucky:             %s\n", lucky_strategy);
+  fprintf(stderr, "Sliced descents:   %lu\n", num_slice_descents);
+  fprintf(stderr, "Walk flips:        %lu\n", num_walk_flips);
+  if (par_num_threads > 1)
+    fprintf(stderr, "Split propagation: %lu watch lists, %d threads\n",
+	    num_split_props, par_num_threads);
+  if (exchange != NULL)
+    fprintf(stderr, "Portfolio:         worker %d of %d, %lu restarts, "
+	    "%lu exported, %lu imported\n", worker_index + 1, num_workers,
+	    num_restarts, num_exported, num_imported);
+  fprintf(stderr, "Swept:             %lu equivalences\n", num_swept);
+  fprintf(stderr, "Autarky:           %lu variables, %lu clauses\n",
+	  num_autarky_vars, num_autarky_clauses);
+  fprintf(stderr, "Gates:             %lu and, %lu xor, %lu ite, %lu equiv, "
+	  "%lu semantic\n", num_and_gates, num_xor_gates, num_ite_gates,
+	  num_equiv_gates, num_semantic_gates);
+  fprintf(stderr, "Memory (now/peak):");
+  mem_print(stderr);
+  fprintf(stderr, "\n");
+  //fprintf(stderr, "Redefinitions:     %lu\n", num_redefinitions);
+  fprintf(stderr, "%1.1lfs ", ((double)(clock() - start_time)) / CLOCKS_PER_SEC);
+  fprintf(stderr, "%1.1zdMb ", getPeakRSS() / 1048576);
+  fprintf(stderr, "\n");
+}
+
+void CDCL_report_SAT()
+{
+  if (report_returns)
+    {
+      reconstruct_model();
+      report_result = SAT;
+      longjmp(report_jump, 1);
+    }
+  if (!exchange_claim())
+    _exit(0);
+  reconstruct_model();
+  print_model();
+  cache_store(SAT);
+  fprintf(stderr, "v SAT\n");
+  CDCL_print_stats();
+  exit(0);
+}
+void CDCL_report_UNSAT()
+{
+  if (report_returns)
+    {
+      report_result = UNSAT;
+      longjmp(report_jump, 1);
+    }
+  if (!exchange_claim())
+    _exit(0);
+  if (itp_filename != NULL)
+    itp_write(itp_clause(itp_conflict != NULL ? itp_conflict : conflict_cls));
+  proof_add(NULL, 0);
+  cache_store(UNSAT);
+  fprintf(stderr, "v UNSAT\n");
+  CDCL_print_stats();
+  exit(0);
+}
+
+// allocates the model, the trail and the per variable data for num_vars
+// variables, with no clauses yet
+void solver_alloc()
+{
+  var_set_size_t which_ass;
+
+  num_asses = num_vars * 2;
+  // initialise model
+  if ((model = (ass_t*)mem_alloc(MEM_MODEL, sizeof(ass_t) * num_asses)) == NULL)
+	error("cannot allocate model");
+#ifdef PACKED_MODEL
+  if ((packed_model = (uint64_t*)mem_calloc(MEM_MODEL, (num_vars + 31) / 32,
+					    sizeof(uint64_t))) == NULL)
+    error("cannot allocate packed model");
+#endif
+  for (which_ass = 0; which_ass < num_asses; which_ass++)
+    {
+      // set default values and initialise watched literals mutable for each assignment
+      if (which_ass < num_vars)
+	value_set(which_ass, UNASSIGNED);
+      mutable_init(&(model[which_ass].watched_lits), MEM_WATCHES);
+    }
+
+  // initialise conflict analysis scratch space
+  if ((seen = (char*)mem_calloc(MEM_ANALYSIS, num_vars, sizeof(char))) == NULL ||
+      (learned_lits = (lit_t*)mem_alloc(MEM_ANALYSIS, sizeof(lit_t) * (num_vars + 1))) == NULL ||
+      (seen_vars = (lit_t*)mem_alloc(MEM_ANALYSIS, sizeof(lit_t) * (num_vars + 1))) == NULL ||
+      (level_counts = (var_set_size_t*)mem_calloc(MEM_ANALYSIS, num_vars + 1,
+					      sizeof(var_set_size_t))) == NULL ||
+      (bin_stamps = (unsigned long*)mem_calloc(MEM_ANALYSIS, num_asses, sizeof(unsigned long))) == NULL)
+	error("cannot allocate conflict analysis");
+
+  // initialise the eliminated variables and the extension stack
+  if ((eliminated = (char*)mem_calloc(MEM_EXTENSION, num_vars, sizeof(char))) == NULL ||
+      (frozen = (unsigned*)mem_calloc(MEM_EXTENSION, num_vars, sizeof(unsigned))) == NULL ||
+      (reconstructed = (lit_t*)mem_calloc(MEM_EXTENSION, num_vars, sizeof(lit_t))) == NULL)
+	error("cannot allocate eliminated variables");
+  num_reconstructed = 0;
+  extension_occs = NULL;
+  extension_starts = NULL;
+  extension_indexed = 0;
+  mutable_init(&extension_stack, MEM_EXTENSION);
+  mutable_init(&amo_constraints, MEM_CLAUSES);
+
+  // initialise the variable classes and level 0 units of interpolation
+  if (itp_filename != NULL)
+    {
+      if ((itp_classes = (char*)mem_calloc(MEM_ANALYSIS, num_vars, sizeof(char))) == NULL ||
+	  (itp_inputs = (lit_t*)mem_calloc(MEM_ANALYSIS, num_vars, sizeof(lit_t))) == NULL ||
+	  (itp_units = (lit_t*)mem_alloc(MEM_ANALYSIS, sizeof(lit_t) * num_vars)) == NULL)
+	error("cannot allocate interpolation");
+      for (which_ass = 0; which_ass < num_vars; which_ass++)
+	itp_units[which_ass] = ITP_NONE;
+      mutable_init(&itp_input_units, MEM_CLAUSES);
+    }
+
+  // initialise the decision order and the literal scores
+  if ((var_order = (lit_t*)mem_alloc(MEM_MODEL, sizeof(lit_t) * num_vars)) == NULL ||
+      (phases = (truth_value_t*)mem_alloc(MEM_MODEL, sizeof(truth_value_t) * num_vars)) == NULL ||
+      (jw_scores = (double*)mem_calloc(MEM_MODEL, num_asses, sizeof(double))) == NULL)
+	error("cannot allocate decision order");
+
+  // initialise trail
+  if ((trail.sequence = (ass_t**)mem_alloc(MEM_TRAIL, sizeof(ass_t*) * num_asses)) == NULL)
+	error("cannot allocate trail sequence");
+  trail.head = trail.sequence;
+  trail.tail = trail.sequence;
+}
+
+// initialises global solver according to the DIMACS file 'input'.
+void CDCL_init(char* DIMACS_filename)
+{
+  FILE* input, *cursor;
+  char buffer[5]; // used only to read the `cnf' string from the input file
+  char ch; // used to read single characters from the input file  
+  DIMACS_lit_t DIMACS_lit; // temporary literal for reading
+  var_set_size_t width; 
+  var_set_size_t which_lit; 
+  cnf_size_t which_clause;
+  cls_t cls;
+  lit_t unit_lit;
+  uint64_t clause_hash;
+  char in_a;
+
+  start_time = clock();
+  state = DECIDE;
+  // set default decision level
+  dec_level = 0;
+
+  // open file connections
+  // TODO: currently using two file connections to find size of clauses before writing
+  // them; it is probably possible to use just one, and to traverse the stream 
+  // backwards when needed
+  if ((input = (FILE *)fopen(DIMACS_filename, "r")) == NULL) error("cannot open file");
+  if ((cursor = (FILE *)fopen(DIMACS_filename, "r")) == NULL) error("cannot open file");
+
+  // parse header
+  // disregard comment lines
+  while ((ch = fgetc(input)) == 'c')
+    while ((ch = fgetc(input)) != '\n')
+      continue;
+  while ((ch = fgetc(cursor)) == 'c')
+    while ((ch = fgetc(cursor)) != '\n')
+      continue;
+  // read header line
+  if (ch != 'p') error("bad input - 'p' not found");
+  if ((fscanf(input, "%s", buffer)) != 1) error("bad input - 'cnf' not found");
+  fscanf(cursor, "%s", buffer);
+
+  // read number of variables
+  if ((fscanf(input, "%lu", &(num_vars))) != 1)
+    error("bad input - number of vars missing");
+  fscanf(cursor, "%lu", &(num_vars));
+  if (num_vars > pow(2,(sizeof(lit_t) * 8) - 3) - 1) // i.e. more variables than our data type can handle
+    error("too many vars");
+  solver_alloc();
+
+  // read number of clauses
+  if(fscanf(input, "%lu", &cnf.size) != 1)
+    error("bad input - number of clauses not found");
+  fscanf(cursor, "%lu", &cnf.size);
+
+  // the hash sums mixed values, so it does not depend on the order of the
+  // clauses nor of the literals in a clause
+  num_input_clauses = cnf.size;
+  formula_hash = hash_mix(num_vars);
+
+  // initialise cnf
+  cnf_capacity = cnf.size;
+  if ((cnf.clauses = (cls_t*)mem_alloc(MEM_CLAUSES, sizeof(cls_t) * cnf_capacity)) == NULL)
+	error("cannot allocate cnf clauses");
+
+  // allocate clauses and add to formula
+  for(which_clause = 0; which_clause < cnf.size; which_clause++)
+    {
+      // find width of clause with cursor
+      fscanf(cursor, "%ld", &DIMACS_lit);
+      for(width = 0; DIMACS_lit != 0; width++) fscanf(cursor, "%ld", &DIMACS_lit);
+      // the clauses not stored make up the difference to the input position
+      in_a = which_clause + num_input_clauses - cnf.size < itp_num_a;
+
+      // if the width is 0, note that the formula is UNSAT
+      if (width == 0)
+	{
+	  fscanf(input, "%ld", &DIMACS_lit);
+	  if (itp_filename != NULL)
+	    {
+	      cls = cls_init(1, MEM_CLAUSES);
+	      cls[0] = 0;
+	      itp_input_clause(cls, in_a);
+	      mutable_push(&itp_input_units, cls);
+	    }
+	  formula_hash += hash_mix(0);
+	  unsat_found = 1;
+	  cnf.size--;
+	  which_clause--;
+	  continue;
+	}
+
+      // if the width is 1, add the assignment as a level 0 unit propagation
+      if (width == 1)
+	{
+	  fscanf(input, "%ld", &DIMACS_lit);
+	  unit_lit = DIMACS_to_lit(DIMACS_lit);
+	  if (itp_filename != NULL)
+	    {
+	      cls = cls_init(2, MEM_CLAUSES);
+	      cls[0] = 1;
+	      cls[1] = unit_lit;
+	      itp_input_clause(cls, in_a);
+	      mutable_push(&itp_input_units, cls);
+	    }
+	  formula_hash += hash_mix(hash_mix(DIMACS_lit) + 1);
+	  jw_add_clause(&unit_lit, 1);
+	  // complementary unit clauses make the formula UNSAT
+	  if (lit_value(DIMACS_to_lit(DIMACS_lit)) == NEGATIVE)
+	    unsat_found = 1;
+	  if (lit_value(DIMACS_to_lit(DIMACS_lit)) == UNASSIGNED)
+	    trail_add_lit(DIMACS_to_lit(DIMACS_lit), PROP_ASS, NULL);
 	  fscanf(input, "%ld", &DIMACS_lit);
 	  state = PROPAGATE;
 	  // we do not store unit clauses, so decrement counters
 	  cnf.size--;
 	  which_clause--;
 	}
-      else 
+      else 
+	{
+	  // initialise clause, with interpolation leaving a slot for its partial
+	  // interpolant
+	  cls = cls_init(width + (itp_filename != NULL), MEM_CLAUSES);
+	  cls[0] = width;
+	  // set liqterals with input
+	  which_lit = 1;
+	  clause_hash = width;
+	  fscanf(input, "%ld", &DIMACS_lit);
+	  while(DIMACS_lit != 0) 
+	    {
+	      cls[which_lit] = DIMACS_to_lit(DIMACS_lit);
+	      clause_hash += hash_mix(DIMACS_lit);
+	      fscanf(input, "%ld", &DIMACS_lit);
+	      which_lit++;
+	    }
+	  
+	  formula_hash += hash_mix(clause_hash);
+	  jw_add_clause(cls + 1, width);
+	  if (itp_filename != NULL)
+	    itp_input_clause(cls, in_a);
+
+	  // put the clause into the cnf
+	  cnf.clauses[which_clause] = cls;
+	  
+	  // watch the first two literals
+	  mutable_push(&(model[get_comp_lit(cls[1])].watched_lits), cls);
+	  mutable_push(&(model[get_comp_lit(cls[2])].watched_lits), cls);
+	}
+    }
+  // initialise empty learned clause list
+  mutable_init(&(learned_cnf), MEM_LEARNED);
+  fclose(input);
+  fclose(cursor);
+
+  if (itp_filename != NULL)
+    itp_init();
+  order_init();
+}
+
+// interpolates between the first num_a clauses of the formula to be
+// initialised and the rest, writing the interpolant to the file if UNSAT
+void CDCL_interpolate(unsigned long num_a, char* aiger_filename)
+{
+  itp_num_a = num_a;
+  itp_filename = aiger_filename;
+}
+
+// writes a DRAT proof of an UNSAT result to the file
+void CDCL_proof(char* proof_filename)
+{
+  if ((proof_file = fopen(proof_filename, "w")) == NULL)
+    error("cannot open proof");
+  if (realpath(proof_filename, proof_path) == NULL)
+    proof_path[0] = '\0';
+}
+
+// answers the formula from the result cache in the given directory, or
+// remembers the directory so that the result is stored there when found
+void CDCL_cache(char* directory, unsigned long max_entries, unsigned long max_bytes)
+{
+  result_t result;
+
+  cache_dir = directory;
+  cache_max_entries = max_entries;
+  cache_max_bytes = max_bytes;
+  cache_status = "miss";
+  // a cached result carries no interpolant, so only new ones are stored
+  if (itp_filename != NULL || (result = cache_lookup()) == UNKNOWN)
+    return;
+  cache_status = "hit";
+  if (result == SAT)
+    CDCL_report_SAT();
+  // the copied proof already ends with the empty clause
+  if (proof_file != NULL)
+    {
+      fclose(proof_file);
+      proof_file = NULL;
+    }
+  CDCL_report_UNSAT();
+}
+
+// switches to incremental use, where results are returned by CDCL_solve
+void CDCL_incremental()
+{
+  incremental = 1;
+}
+
+// keeps the variable of the literal in the formula through simplification,
+// reintroducing it if it was eliminated. freezes are counted, and undone by
+// as many melts
+void CDCL_freeze(long DIMACS_lit)
+{
+  lit_t var;
+
+  if (labs(DIMACS_lit) > (long)num_vars || DIMACS_lit == 0)
+    error("bad freeze - literal out of range");
+  var = get_var(DIMACS_to_lit(DIMACS_lit));
+  frozen[var]++;
+  if (eliminated[var])
+    {
+      incremental_reset();
+      reintroduce(var);
+    }
+}
+
+void CDCL_melt(long DIMACS_lit)
+{
+  lit_t var;
+
+  if (labs(DIMACS_lit) > (long)num_vars || DIMACS_lit == 0)
+    error("bad melt - literal out of range");
+  var = get_var(DIMACS_to_lit(DIMACS_lit));
+  if (frozen[var] == 0)
+    error("melting a variable that is not frozen");
+  frozen[var]--;
+}
+
+// adds a clause of the given DIMACS literals to the formula, reintroducing the
+// eliminated variables it contains
+void CDCL_add_clause(long* DIMACS_lits, int width)
+{
+  cls_t cls;
+  int which_lit;
+
+  incremental_reset();
+  cls = cls_init(width, MEM_CLAUSES);
+  for (which_lit = 0; which_lit < width; which_lit++)
+    {
+      if (labs(DIMACS_lits[which_lit]) > (long)num_vars || DIMACS_lits[which_lit] == 0)
+	error("bad incremental clause - literal out of range");
+      cls[which_lit + 1] = DIMACS_to_lit(DIMACS_lits[which_lit]);
+      if (eliminated[get_var(cls[which_lit + 1])])
+	reintroduce(get_var(cls[which_lit + 1]));
+    }
+  incremental_add(cls);
+}
+
+// assumes the literal in the next call of CDCL_solve only
+void CDCL_assume(long DIMACS_lit)
+{
+  if (labs(DIMACS_lit) > (long)num_vars || DIMACS_lit == 0)
+    error("bad assumption - literal out of range");
+  if (num_assumptions == assumptions_capacity)
+    {
+      assumptions_capacity = 2 * assumptions_capacity + 1;
+      if ((assumptions = (lit_t*)(assumptions == NULL ?
+				  mem_alloc(MEM_OTHER, sizeof(lit_t) * assumptions_capacity) :
+				  mem_realloc(assumptions, sizeof(lit_t) * assumptions_capacity))) == NULL)
+	error("cannot allocate assumptions");
+    }
+  assumptions[num_assumptions++] = DIMACS_to_lit(DIMACS_lit);
+  if (eliminated[get_var(assumptions[num_assumptions - 1])])
+    {
+      incremental_reset();
+      reintroduce(get_var(assumptions[num_assumptions - 1]));
+    }
+}
+
+// searches from level 0 and returns the result instead of exiting. after SAT,
+// the model is read with CDCL_value until the next call that changes the
+// formula
+int CDCL_solve()
+{
+  result_t result;
+
+  incremental_reset();
+  report_returns = 1;
+  if (setjmp(report_jump) != 0)
+    {
+      report_returns = 0;
+      result = report_result;
+      if (result == UNSAT && !assumption_failed)
+	unsat_found = 1;
+      num_assumptions = 0;
+      assumption_failed = 0;
+      return result == SAT;
+    }
+  if (unsat_found || CDCL_prop() == CONFLICT)
+    CDCL_report_UNSAT();
+  while (CDCL_decide() != SUCCESS)
+    while (CDCL_prop() == CONFLICT)
+      CDCL_repair_conflict();
+  CDCL_report_SAT();
+  return 1;
+}
+
+// returns 1 if the literal is true in the model of the last SAT result, -1 if
+// it is false and 0 if it is unassigned
+int CDCL_value(long DIMACS_lit)
+{
+  if (labs(DIMACS_lit) > (long)num_vars || DIMACS_lit == 0)
+    error("bad value - literal out of range");
+  return lit_value(DIMACS_to_lit(DIMACS_lit));
+}
+
+// checks the property of the AIGER circuit up to the bound, unrolling it one
+// frame at a time into a single incremental solver. each bound proven is
+// printed as u<bound>, followed by a counterexample in the AIGER witness format
+// or an unknown result once the bound is reached
+void CDCL_bmc(char* aiger_filename, unsigned long max_bound)
+{
+  aiger_t aig;
+  unsigned long bound;
+  DIMACS_lit_t lits[1];
+  lit_t var;
+
+  start_time = clock();
+  state = DECIDE;
+  dec_level = 0;
+  aiger_read(&aig, aiger_filename);
+  if ((double)(max_bound + 1) * (aig.max_var + 1) + 1 > pow(2,(sizeof(lit_t) * 8) - 3) - 1)
+    error("too many vars");
+  num_vars = 1 + (aig.max_var + 1);
+  solver_alloc();
+  cnf.size = 0;
+  cnf_capacity = 1;
+  if ((cnf.clauses = (cls_t*)mem_alloc(MEM_CLAUSES, sizeof(cls_t) * cnf_capacity)) == NULL)
+    error("cannot allocate cnf clauses");
+  mutable_init(&learned_cnf, MEM_LEARNED);
+  incremental = 1;
+
+  // the frames are decided in order, with false phases
+  for (var = 0; var < num_vars; var++)
+    {
+      var_order[var] = var;
+      phases[var] = NEGATIVE;
+      eliminated[var] = var > 0;
+    }
+  mem_free(jw_scores);
+  jw_scores = NULL;
+  lits[0] = 1;
+  bmc_add(lits, 1);
+
+  for (bound = 0; bound <= max_bound; bound++)
+    {
+      bmc_frame(&aig, bound, max_bound);
+      CDCL_assume(bmc_activation(&aig, bound));
+      if (CDCL_solve())
+	{
+	  bmc_witness(&aig, bound);
+	  break;
+	}
+      // without a path of this length the property holds at every bound
+      if (unsat_found)
 	{
-	  // initialise clause
-	  cls = cls_init(width);
-	  // set liqterals with input
-	  which_lit = 1;
-	  fscanf(input, "%ld", &DIMACS_lit);
-	  while(DIMACS_lit != 0) 
+	  printf("0\nb0\n.\n");
+	  break;
+	}
+      printf("u%lu\n", bound);
+      fflush(stdout);
+      // retire the bad state clause, and keep its negated literal as a lemma
+      lits[0] = -bmc_activation(&aig, bound);
+      CDCL_add_clause(lits, 1);
+      lits[0] = -bmc_lit(&aig, bound, aig.bad);
+      CDCL_add_clause(lits, 1);
+    }
+  if (bound > max_bound)
+    printf("2\nb0\n.\n");
+  fprintf(stderr, "Bound:             %lu of %lu\n", bound > max_bound ? max_bound : bound,
+	  max_bound);
+  CDCL_print_stats();
+  aiger_free(&aig);
+}
+
+// prints a progress line every given number of conflicts
+void CDCL_progress(unsigned long interval)
+{
+  progress_interval = interval;
+}
+
+void CDCL_parallel_prop(int num_threads)
+{
+  par_num_threads = num_threads < 1 ? 1 :
+    num_threads > PAR_MAX_THREADS ? PAR_MAX_THREADS : num_threads;
+}
+
+void CDCL_stats_signal()
+{
+  struct sigaction action;
+
+  // interrupted reads and waits are restarted rather than failing
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = stats_signal;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGUSR1, &action, NULL) != 0)
+    error("cannot install signal handler");
+}
+
+void CDCL_poll_stats()
+{
+  if (!stats_requested)
+    return;
+  stats_requested = 0;
+  CDCL_print_stats();
+  print_progress();
+  fflush(stderr);
+}
+
+// extracts the features of the formula and switches to the configuration of
+// the nearest centroid of the selection model in the given file, or of the
+// built-in model if the filename is NULL
+void CDCL_select(char* model_filename)
+{
+  config_t configs[MAX_CONFIGS];
+  double centroids[MAX_CONFIGS][NUM_FEATURES];
+  double distance;
+  int num_configs, which_config, which_feature, nearest = 0;
+
+  extract_features();
+  if (model_filename != NULL)
+    num_configs = read_configs(model_filename, configs, centroids);
+  else
+    {
+      num_configs = sizeof(builtin_configs) / sizeof(config_t);
+      memcpy(configs, builtin_configs, sizeof(builtin_configs));
+      memcpy(centroids, builtin_centroids, sizeof(builtin_centroids));
+    }
+  for (which_config = 0; which_config < num_configs; which_config++)
+    {
+      distance = 0;
+      for (which_feature = 0; which_feature < NUM_FEATURES; which_feature++)
+	distance += (features[which_feature] - centroids[which_config][which_feature]) *
+	  (features[which_feature] - centroids[which_config][which_feature]);
+      distance = sqrt(distance);
+      if (which_config == 0 || distance < config_distance)
+	{
+	  nearest = which_config;
+	  config_distance = distance;
+	}
+    }
+  config = configs[nearest];
+  apply_config();
+}
+
+// simplifies the formula at decision level 0: propagates the input units,
+// replaces at-most-one encodings by native constraints, substitutes equivalent
+// variables, removes an autarky, eliminates variables, and propagates the
+// units this produces
+void CDCL_preprocess()
+{
+  incremental_reset();
+  if (unsat_found || CDCL_prop() == CONFLICT)
+    {
+      // in incremental use the result is left to CDCL_solve
+      unsat_found = 1;
+      if (!incremental)
+	CDCL_report_UNSAT();
+      return;
+    }
+  // interpolation follows the resolutions of the search, which the
+  // simplifications would not record
+  if (itp_filename != NULL)
+    return;
+  pre_init();
+  if (config.amos)
+    pre_detect_amos();
+  if (config.sweep)
+    pre_sweep();
+  if (config.autarky)
+    pre_autarky();
+  if (config.eliminate)
+    pre_eliminate_vars();
+  pre_finish();
+  if (unsat_found || CDCL_prop() == CONFLICT)
+    {
+      unsat_found = 1;
+      if (!incremental)
+	CDCL_report_UNSAT();
+    }
+}
+
+// tries the lucky strategies in turn and reports SAT on the first that works
+void CDCL_lucky()
+{
+  clock_t deadline;
+
+  deadline = clock() + (clock_t)(LUCKY_TIME_LIMIT * CLOCKS_PER_SEC);
+  if (lucky_constant(NEGATIVE))
+    lucky_strategy = "all false";
+  else if (lucky_constant(POSITIVE))
+    lucky_strategy = "all true";
+  else if (lucky_greedy(NEGATIVE, 0, deadline))
+    lucky_strategy = "forward false";
+  else if (clock() <= deadline && lucky_greedy(POSITIVE, 0, deadline))
+    lucky_strategy = "forward true";
+  else if (clock() <= deadline && lucky_greedy(NEGATIVE, 1, deadline))
+    lucky_strategy = "backward false";
+  else if (clock() <= deadline && lucky_greedy(POSITIVE, 1, deadline))
+    lucky_strategy = "backward true";
+  else
+    return;
+  CDCL_report_SAT();
+}
+
+// runs the bit-sliced search on small formulas for the given number of rounds
+// per variable, and reports SAT with the first lane that assigns every variable
+// without conflict
+void CDCL_slice(unsigned long rounds_per_var)
+{
+  clock_t deadline;
+  lit_t var, which_var;
+  slice_word_t conflicts[SLICE_WORDS], complete[SLICE_WORDS], open, random;
+  slice_word_t tried_pos, tried_neg, all_conflicts;
+  unsigned long rounds_left, num_descents = 0;
+  var_set_size_t index;
+  int word, winner_word = -1, winner_bit = 0;
+  char at_base = 1;
+
+  if (num_vars > SLICE_MAX_VARS || num_vars == 0)
+    return;
+  if ((slice_pos = (slice_word_t*)mem_alloc(MEM_SEARCH, sizeof(slice_word_t) * num_vars * SLICE_WORDS)) == NULL ||
+      (slice_neg = (slice_word_t*)mem_alloc(MEM_SEARCH, sizeof(slice_word_t) * num_vars * SLICE_WORDS)) == NULL ||
+      (slice_base_pos = (slice_word_t*)mem_alloc(MEM_SEARCH, sizeof(slice_word_t) * num_vars * SLICE_WORDS)) == NULL ||
+      (slice_base_neg = (slice_word_t*)mem_alloc(MEM_SEARCH, sizeof(slice_word_t) * num_vars * SLICE_WORDS)) == NULL)
+    error("cannot allocate bit-sliced search");
+  for (var = 0; var < num_vars; var++)
+    for (word = 0; word < SLICE_WORDS; word++)
+      {
+	index = var * SLICE_WORDS + word;
+	slice_base_pos[index] = (lit_value(var) == POSITIVE ||
+				 eliminated[var]) ? ~(slice_word_t)0 : 0;
+	slice_base_neg[index] = lit_value(var) == NEGATIVE ?
+	  ~(slice_word_t)0 : 0;
+	slice_pos[index] = slice_base_pos[index];
+	slice_neg[index] = slice_base_neg[index];
+      }
+  slice_seed = 0x2545f4914f6cdd1dULL;
+  deadline = clock() + (clock_t)(SLICE_TIME_LIMIT * CLOCKS_PER_SEC);
+  rounds_left = rounds_per_var * num_vars;
+
+  while (winner_word == -1 && rounds_left-- > 0 && clock() <= deadline)
+    {
+      // decide the first variable open in some lane
+      for (which_var = 0; which_var < num_vars; which_var++)
+	{
+	  var = var_order[which_var];
+	  for (word = 0; word < SLICE_WORDS; word++)
+	    if (~(slice_pos[var * SLICE_WORDS + word] | slice_neg[var * SLICE_WORDS + word]))
+	      break;
+	  if (word < SLICE_WORDS)
+	    break;
+	}
+      tried_pos = tried_neg = 0;
+      for (word = 0; word < SLICE_WORDS && which_var < num_vars; word++)
+	{
+	  index = var * SLICE_WORDS + word;
+	  open = ~(slice_pos[index] | slice_neg[index]);
+	  random = slice_random();
+	  slice_pos[index] |= open & random;
+	  slice_neg[index] |= open & ~random;
+	  tried_pos |= open & random;
+	  tried_neg |= open & ~random;
+	}
+
+      // propagate, restart the lanes in conflict, and look for a lane that
+      // has every variable assigned
+      for (word = 0; word < SLICE_WORDS; word++)
+	{
+	  conflicts[word] = 0;
+	  while (slice_prop_word(word, conflicts + word))
+	    continue;
+	  complete[word] = ~conflicts[word];
+	}
+      for (var = 0; var < num_vars; var++)
+	for (word = 0; word < SLICE_WORDS; word++)
+	  {
+	    index = var * SLICE_WORDS + word;
+	    complete[word] &= slice_pos[index] | slice_neg[index];
+	    slice_pos[index] = (slice_pos[index] & ~conflicts[word]) |
+	      (slice_base_pos[index] & conflicts[word]);
+	    slice_neg[index] = (slice_neg[index] & ~conflicts[word]) |
+	      (slice_base_neg[index] & conflicts[word]);
+	  }
+      all_conflicts = ~(slice_word_t)0;
+      for (word = 0; word < SLICE_WORDS; word++)
+	{
+	  num_descents += __builtin_popcountll(conflicts[word]);
+	  all_conflicts &= conflicts[word];
+	  if (complete[word] != 0 && winner_word == -1)
 	    {
-	      cls[which_lit] = DIMACS_to_lit(DIMACS_lit);
-	      fscanf(input, "%ld", &DIMACS_lit);
-	      which_lit++;
+	      winner_word = word;
+	      winner_bit = __builtin_ctzll(complete[word]);
 	    }
-	  
-	  // put the clause into the cnf
-	  cnf.clauses[which_clause] = cls;
-	  
-	  // watch the first two literals
-	  mutable_push(&(model[get_comp_lit(cls[1])].watched_lits), cls);
-	  mutable_push(&(model[get_comp_lit(cls[2])].watched_lits), cls);
 	}
+
+      // give up once the lanes keep conflicting back to level 0
+      if ((all_conflicts == ~(slice_word_t)0 && at_base &&
+	   (which_var == num_vars || (tried_pos != 0 && tried_neg != 0))) ||
+	  num_descents >= SLICE_MAX_RESTARTS * SLICE_WORDS * 64)
+	break;
+      at_base = all_conflicts == ~(slice_word_t)0;
     }
-  // set default decision level
-  dec_level = 0;
-  // initialise empty learned clause list
-  mutable_init(&(learned_cnf));
+
+  num_slice_descents += num_descents;
+
+  // decide the remaining variables as the winning lane has them on one level
+  if (winner_word != -1)
+    {
+      dec_level++;
+      for (var = 0; var < num_vars; var++)
+	if (lit_value(var) == UNASSIGNED && !eliminated[var])
+	  trail_add_lit(((slice_pos[var * SLICE_WORDS + winner_word] >> winner_bit) & 1) ?
+			var : get_comp_lit(var), DEC_ASS, NULL);
+      trail.head = trail.tail;
+    }
+  mem_free(slice_pos);
+  mem_free(slice_neg);
+  mem_free(slice_base_pos);
+  mem_free(slice_base_neg);
+  if (winner_word != -1)
+    CDCL_report_SAT();
+}
+
+// runs the walkers in parallel for a bounded time, and reports SAT with the
+// assignment of the first walker that satisfies the formula
+void CDCL_walk(int num_walkers)
+{
+  walker_t* walkers;
+  int which_walker;
+  lit_t var;
+
+  walk_arena_init();
+  if ((walkers = (walker_t*)mem_alloc(MEM_SEARCH, sizeof(walker_t) * num_walkers)) == NULL)
+    error("cannot allocate walkers");
+  for (which_walker = 0; which_walker < num_walkers; which_walker++)
+    walker_init(walkers + which_walker, which_walker, num_walkers);
+
+  walk_winner = NULL;
+  walk_deadline = time(NULL) + WALK_TIME_LIMIT;
+  for (which_walker = 0; which_walker < num_walkers; which_walker++)
+    if (pthread_create(&walkers[which_walker].thread, NULL, walker_run,
+		       walkers + which_walker) != 0)
+      error("cannot start walker");
+  for (which_walker = 0; which_walker < num_walkers; which_walker++)
+    {
+      pthread_join(walkers[which_walker].thread, NULL);
+      num_walk_flips += walkers[which_walker].flips;
+    }
+
+  // decide the remaining variables as the winner has them on one level
+  if (walk_winner != NULL)
+    {
+      dec_level++;
+      for (var = 0; var < num_vars; var++)
+	if (lit_value(var) == UNASSIGNED && !eliminated[var])
+	  trail_add_lit(walk_winner->values[var] ? var : get_comp_lit(var),
+			DEC_ASS, NULL);
+      trail.head = trail.tail;
+    }
+  for (which_walker = 0; which_walker < num_walkers; which_walker++)
+    walker_free(walkers + which_walker);
+  mem_free(walkers);
+  walk_arena_free();
+  if (walk_winner != NULL)
+    CDCL_report_SAT();
+}
+
+// forks the workers of a portfolio, which return from here with different
+// phases and decision orders. the parent waits for the winner to report,
+// kills the others, and exits
+void CDCL_portfolio(int workers)
+{
+  pid_t* pids;
+  pid_t pid;
+  int which_worker, num_running, winner;
+  lit_t var, temp_var;
+
+  // imported clauses have no partial interpolants and the workers would write
+  // one proof together, so interpolation and proofs search alone
+  if (itp_filename != NULL || proof_file != NULL)
+    return;
+  if ((exchange = (exchange_t*)mmap(NULL, sizeof(exchange_t),
+				    PROT_READ | PROT_WRITE,
+				    MAP_SHARED | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED)
+    error("cannot map clause exchange");
+  if ((pids = (pid_t*)mem_alloc(MEM_OTHER, sizeof(pid_t) * workers)) == NULL)
+    error("cannot allocate portfolio");
+  num_workers = workers;
+  portfolio_parent = getpid();
+  arena_init();
+  restart_unit = RESTART_UNIT;
+  restart_limit = RESTART_UNIT;
+  fflush(stdout);
+  fflush(stderr);
+
+  for (which_worker = 0; which_worker < workers; which_worker++)
+    {
+      if ((pid = fork()) < 0)
+	error("cannot fork worker");
+      if (pid > 0)
+	{
+	  pids[which_worker] = pid;
+	  continue;
+	}
+
+      // odd workers take the opposite phases, every other pair of workers
+      // decides the variables in reverse order
+      mem_free(pids);
+      worker_index = which_worker;
+      // the propagation helpers of the parent are not in the worker
+      par_running = 0;
+      if (worker_index % 2 == 1)
+	for (var = 0; var < num_vars; var++)
+	  phases[var] = phases[var] == POSITIVE ? NEGATIVE : POSITIVE;
+      if (worker_index / 2 % 2 == 1)
+	for (var = 0; var < num_vars / 2; var++)
+	  {
+	    temp_var = var_order[var];
+	    var_order[var] = var_order[num_vars - 1 - var];
+	    var_order[num_vars - 1 - var] = temp_var;
+	  }
+      return;
+    }
+
+  // a worker that crashes does not stop the others
+  winner = 0;
+  for (num_running = workers; num_running > 0; num_running--)
+    {
+      pid = wait(NULL);
+      winner = __atomic_load_n(&exchange->winner, __ATOMIC_ACQUIRE);
+      if (winner != 0 && pid == pids[winner - 1])
+	break;
+    }
+  for (which_worker = 0; which_worker < workers; which_worker++)
+    kill(pids[which_worker], SIGKILL);
+  while (wait(NULL) > 0)
+    continue;
+  mem_free(pids);
+  if (winner == 0)
+    error("all portfolio workers failed");
+  exit(0);
 }
 
 void CDCL_free()
@@ -637,20 +6678,75 @@ void CDCL_free()
   var_set_size_t which_ass;
 
   // free memory for the cnf
-  for (which_clause = 0; which_clause < cnf.size; which_clause++)
-    cls_free(cnf.clauses[which_clause]);
-  free(cnf.clauses);
+  if (arena != NULL)
+    {
+      mem_free(arena);
+      mem_free(watch_pairs);
+    }
+  else
+    for (which_clause = 0; which_clause < cnf.size; which_clause++)
+      cls_free(cnf.clauses[which_clause]);
+  mem_free(cnf.clauses);
     
   // free memory for the learned cnf
   mutable_free_clauses(&learned_cnf);
 
+  // free memory for the eliminated clauses
+  mutable_free_clauses(&extension_stack);
+  mem_free(eliminated);
+  mem_free(reconstructed);
+  mem_free(extension_occs);
+  mem_free(extension_starts);
+  mem_free(frozen);
+
+  // free memory for the at-most-one constraints
+  mutable_free_clauses(&amo_constraints);
+  if (amo_watches != NULL)
+    {
+      for (which_ass = 0; which_ass < num_asses; which_ass++)
+	mutable_free(amo_watches + which_ass);
+      mem_free(amo_watches);
+    }
+
   // free memory for the model
   for (which_ass = 0; which_ass < num_asses; which_ass++)
     mutable_free(&(model[which_ass].watched_lits));
-  free(model);
+  mem_free(model);
+#ifdef PACKED_MODEL
+  mem_free(packed_model);
+#endif
   
   // free memory for the trail
-  free(trail.sequence);
+  mem_free(trail.sequence);
+
+  // free memory for conflict analysis
+  mem_free(seen);
+  mem_free(learned_lits);
+  mem_free(seen_vars);
+  mem_free(level_counts);
+  mem_free(bin_stamps);
+
+  // free memory for the decision order
+  mem_free(var_order);
+  mem_free(phases);
+
+  // free memory for interpolation
+  if (itp_filename != NULL)
+    {
+      mutable_free_clauses(&itp_input_units);
+      mem_free(itp_classes);
+      mem_free(itp_inputs);
+      mem_free(itp_units);
+      mem_free(itp_nodes);
+      mem_free(itp_table);
+    }
+
+  // close the proof
+  if (proof_file != NULL)
+    {
+      fclose(proof_file);
+      proof_file = NULL;
+    }
 }
 
 // TODO: the watched literals should be the first two in the clause
@@ -673,165 +6769,165 @@ void CDCL_free()
 // the function first attemps to push the watch to another literal
 // if the clause is found to be unit, the assignment is checked for conflict
 // if conflict is found, the watched literals for the current assignment are
-// cleaned up and the function returns CONFLICT
+// cleaned up and the function returns CONFLICT, with the falsified clause in
+// conflict_cls
 // if no conflict is found, the unit assignment is added to the tail of the trail
 // when all clauses have been visited, the trail head is incremented
 // the function returns NO_CONFLICT when head and tail are again identical
 
-state_t CDCL_prop()
+state_t prop_lit()
 {
-
-  lit_t* watched_lit, *other_watched_lit, *candidate_lit;
+  // propagates the literal at the head of the trail through its watched
+  // clauses and at-most-one constraints. returns CONFLICT, or PROPAGATE once
+  // the head has moved on
+  lit_t* watches, *watched_lit, *other_watched_lit, *candidate_lit;
   lit_t temp_lit;
   var_set_size_t which_lit;
   cls_t clause;
   cnf_size_t num_clauses, which_clause;
   mutable_t new_watchers;
   model_size_t propagator, width;
-  ass_t** temp_head;
   lit_t** data;
   //ass_t* ass;
 
-  DEBUG_MSG(fprintf(stderr, "In CDCL_prop()..\n"));
+  // store the literal that we are propagating
+  propagator = *(trail.head) - model;
+  if (par_num_threads > 1 && model[propagator].watched_lits.used >= PAR_PROP_MIN)
+    return par_prop_lit(propagator);
   
-  while (trail.head != trail.tail)
+  // fetch a pointer to the list of watched literals, and its size 
+  data = model[propagator].watched_lits.data;
+  num_clauses = model[propagator].watched_lits.used;
+
+  // initialise a new mutable for the replacement list
+  mutable_init(&new_watchers, MEM_WATCHES);
+
+  DEBUG_MSG(fprintf(stderr, "Propagating literal %ld on %lu clauses\n",
+		    lit_to_DIMACS(propagator), num_clauses));
+  DEBUG_MSG(print_model());
+  DEBUG_MSG(print_trail());
+  DEBUG_MSG(print_watched_lits());
+  
+  // cycle through the watched literals' clauses
+  for (which_clause = 0; which_clause < num_clauses; which_clause++)
     {
-      // store the literal that we are propagating
-      propagator = *(trail.head) - model;
-      
-      // add the propagating assignment to the model, set all successive additions
-      // as propagations
-      assign_by_lit(propagator);
-      
-      // fetch a pointer to the list of watched literals, and its size 
-      data = model[propagator].watched_lits.data;
-      num_clauses = model[propagator].watched_lits.used;
-
-      // initialise a new mutable for the replacement list
-      mutable_init(&new_watchers);
-
-      DEBUG_MSG(fprintf(stderr, "Propagating literal %ld on %lu clauses\n",
-			lit_to_DIMACS(propagator), num_clauses));
-      DEBUG_MSG(print_model());
-      DEBUG_MSG(print_trail());
-      DEBUG_MSG(print_watched_lits());
-      
-      // cycle through the watched literals' clauses
-      for (which_clause = 0; which_clause < num_clauses; which_clause++)
-	{
-	  // get the current clause and its width
-	  clause = data[which_clause];
-	  width = *clause;
-
-	  DEBUG_MSG(fprintf(stderr, "Dealing with clause: "));
-	  DEBUG_MSG(cls_print(clause));
+      // get the current clause and its width
+      clause = data[which_clause];
+      width = *clause;
 
-	  // get pointers to the watched literal being processed,
-	  // the other watched literal, and the first candidate literal
-	  if (clause[1] == get_comp_lit(propagator))
-	    {
-	      watched_lit = clause + 1;
-	      other_watched_lit = clause + 2;
-	    }
-	  else
-	    {
-	      watched_lit = clause + 2;
-	      other_watched_lit = clause + 1;
-	    }
+      DEBUG_MSG(fprintf(stderr, "Dealing with clause: "));
+      DEBUG_MSG(cls_print(clause));
 
-	  // if the other watched literal is satisfied, we leave the clause as it is
-	  if (lit_truth_value(other_watched_lit) == POSITIVE)  
-	    {
-	      // so the watched literal goes onto the replacement list
-	      mutable_push(&new_watchers, clause);
+      // get pointers to the watched literal being processed and the other
+      // watched literal, in the clause or in its pair
+      watches = cls_watches(clause);
+      if (watches[0] == get_comp_lit(propagator))
+	{
+	  watched_lit = watches;
+	  other_watched_lit = watches + 1;
+	}
+      else
+	{
+	  watched_lit = watches + 1;
+	  other_watched_lit = watches;
+	}
 
-	      DEBUG_MSG(fprintf(stderr, " -> "));
-	      DEBUG_MSG(cls_print(clause));
-	      DEBUG_MSG(fprintf(stderr, 
-				" (no change - other watched literal is satisfied)\n"));
-	    }
-	  else
+      // if the other watched literal is satisfied, we leave the clause as it is
+      if (lit_value(*other_watched_lit) == POSITIVE)  
+	{
+	  // so the watched literal goes onto the replacement list
+	  mutable_push(&new_watchers, clause);
+
+	  DEBUG_MSG(fprintf(stderr, " -> "));
+	  DEBUG_MSG(cls_print(clause));
+	  DEBUG_MSG(fprintf(stderr, 
+			    " (no change - other watched literal is satisfied)\n"));
+	}
+      else
+	{
+	  // cycle through the remaining candidate literals, all of them for a
+	  // clause of the arena
+	  for(which_lit = watches == clause + 1 ? 3 : 1; which_lit <= width; which_lit++)
 	    {
-	      // cycle through the remaining candidate literals 
-	      for(which_lit = 3; which_lit <= width; which_lit++)
+	      candidate_lit = clause + which_lit;
+	      if (lit_value(*candidate_lit) != NEGATIVE &&
+		  *candidate_lit != *other_watched_lit)
 		{
-		  candidate_lit = clause + which_lit;
-		  if (lit_truth_value(candidate_lit) != NEGATIVE)
-		    {
-		      // we found an eligible literal
-		      // swap it for the original watched literal
-		      temp_lit = *candidate_lit;
-		      *candidate_lit = *watched_lit;
-		      *watched_lit = temp_lit;
-		      // add it to the appropriate list
-		      mutable_push(&(model[get_comp_lit(*watched_lit)].watched_lits),
-				   clause);
-
-		      DEBUG_MSG(fprintf(stderr, " -> "));
-		      DEBUG_MSG(cls_print(clause));
-		      DEBUG_MSG(fprintf(stderr, "\n"));
-		      
-		      // force inner loop to terminate
-		      break;
-		    }
+		  // we found an eligible literal
+		  // swap it for the original watched literal
+		  temp_lit = *candidate_lit;
+		  if (watches == clause + 1)
+		    *candidate_lit = *watched_lit;
+		  *watched_lit = temp_lit;
+		  // add it to the appropriate list
+		  mutable_push(&(model[get_comp_lit(*watched_lit)].watched_lits),
+			       clause);
+
+		  DEBUG_MSG(fprintf(stderr, " -> "));
+		  DEBUG_MSG(cls_print(clause));
+		  DEBUG_MSG(fprintf(stderr, "\n"));
+		  
+		  // force inner loop to terminate
+		  break;
 		}
-	      if (which_lit > width)
-		{
-		  // we have a unit clause based on the other watched literal
-		  DEBUG_MSG(fprintf(stderr, "found unit clause %ld",
-				    lit_to_DIMACS(*other_watched_lit)));
-		  num_unit_props++;
-		  // the watched literal should be placed on the replacement list
-		  mutable_push(&new_watchers, clause);  
-
-		  // the implied assignment is not in the model, nor is its negation
-		  // but either may be on the trail
-		  // cycle through the trail
-		  for (temp_head = trail.sequence; temp_head < trail.tail; temp_head++)
-		    {
-		      if (*other_watched_lit == *temp_head - model)
-			{ // the implied assignment is already on the trail
-			  DEBUG_MSG(fprintf(stderr,
-					    " -- ignoring repeated unit clause.\n"));			  
-			  break;
-			}
-		      if (*other_watched_lit == get_comp_lit(*temp_head - model))
-			// the implied assignment yields a conflict
-			{
-			  DEBUG_MSG(fprintf(stderr,
-					    " -- detected conflict - aborting propagation.\n"));
-			  // add clauses for unprocessed watched literals to replacement
-			  // list
-			  for (which_clause++; which_clause < num_clauses; which_clause++)
-			      mutable_push(&new_watchers, data[which_clause]);
-			  // free the old data and instate the new list
-			  mutable_free(&(model[propagator].watched_lits));
-			  model[propagator].watched_lits = new_watchers;
-			  return CONFLICT;
-			}
-		    }
-		  if (temp_head == trail.tail)
-		    {
-		      // add unit assignment to trail
-		      trail_add_lit(*other_watched_lit, PROP_ASS);
-		      DEBUG_MSG(fprintf(stderr,
-					" -- added to trail.\n"));
+	    }
+	  if (which_lit > width)
+	    {
+	      // we have a unit clause based on the other watched literal
+	      DEBUG_MSG(fprintf(stderr, "found unit clause %ld",
+				lit_to_DIMACS(*other_watched_lit)));
+	      num_unit_props++;
+	      // the watched literal should be placed on the replacement list
+	      mutable_push(&new_watchers, clause);  
 
-		    }
+	      // the other watched literal is either unassigned or false,
+	      // since satisfied clauses were dealt with above
+	      if (lit_value(*other_watched_lit) == NEGATIVE)
+		// the implied assignment yields a conflict
+		{
+		  DEBUG_MSG(fprintf(stderr,
+				    " -- detected conflict - aborting propagation.\n"));
+		  conflict_cls = clause;
+		  // add clauses for unprocessed watched literals to replacement
+		  // list
+		  for (which_clause++; which_clause < num_clauses; which_clause++)
+		    mutable_push(&new_watchers, data[which_clause]);
+		  // free the old data and instate the new list
+		  mutable_free(&(model[propagator].watched_lits));
+		  model[propagator].watched_lits = new_watchers;
+		  return CONFLICT;
 		}
+	      // add unit assignment to trail, with the clause as reason
+	      trail_add_lit(*other_watched_lit, PROP_ASS, clause);
+	      DEBUG_MSG(fprintf(stderr,
+				" -- added to trail.\n"));
 	    }
 	}
-      // propagation for this assignment has completed without conflict
-      // instate new watched lits      
-      mutable_free(&(model[propagator].watched_lits));
-      model[propagator].watched_lits = new_watchers;
-
-      // increment head
-      trail.head++;
-      DEBUG_MSG(fprintf(stderr,
-			"Completed propagation on literal %ld without conflict\n",
-			lit_to_DIMACS(propagator)));
     }
+  // propagation for this assignment has completed without conflict
+  // instate new watched lits      
+  mutable_free(&(model[propagator].watched_lits));
+  model[propagator].watched_lits = new_watchers;
+
+  // propagate the at-most-one constraints containing the literal
+  if (amo_watches != NULL && amo_prop(propagator) == CONFLICT)
+    return CONFLICT;
+
+  // increment head
+  trail.head++;
+  DEBUG_MSG(fprintf(stderr,
+		    "Completed propagation on literal %ld without conflict\n",
+		    lit_to_DIMACS(propagator)));
+  return PROPAGATE;
+}
+
+state_t CDCL_prop()
+{
+  DEBUG_MSG(fprintf(stderr, "In CDCL_prop()..\n"));
+  
+  while (trail.head != trail.tail)
+    if (prop_lit() == CONFLICT)
+      return CONFLICT;
 
   // propagation terminates without a conflict
   DEBUG_MSG(fprintf(stderr,"Propagation cycle complete.\n"));
@@ -845,26 +6941,45 @@ state_t CDCL_prop()
 // the final assignment, trail.tail to the next location.  
 int CDCL_decide()
 {
-  model_size_t which_ass;
+  var_set_size_t which_var;
+  lit_t var;
 
   DEBUG_MSG(fprintf(stderr, "In CDCL_decide(). "));
   num_decisions++;
 
-  // find an unassigned var
-  for (which_ass = 0; which_ass < num_vars; which_ass++)
+  // decide the assumptions first. a true one gets a level without a
+  // decision, and a false one makes the call UNSAT
+  while (dec_level < num_assumptions)
+    {
+      var = assumptions[dec_level];
+      if (lit_value(var) == NEGATIVE)
+	{
+	  assumption_failed = 1;
+	  CDCL_report_UNSAT();
+	}
+      dec_level++;
+      if (lit_value(var) == UNASSIGNED)
+	{
+	  trail_add_lit(var, DEC_ASS, NULL);
+	  return PROPAGATE;
+	}
+    }
+
+  // find the first unassigned var in the decision order
+  for (which_var = 0; which_var < num_vars; which_var++)
     {
-      if(model[which_ass].truth_value == UNASSIGNED)
+      var = var_order[which_var];
+      if(lit_value(var) == UNASSIGNED && !eliminated[var])
 	{
-	  // set assignment type
-	  model[which_ass].ass_type = DEC_ASS;
-	  model[which_ass + num_vars].ass_type = DEC_ASS;
-	  // put the assignment on the trail
-	  trail_add_lit(which_ass, DEC_ASS);
 	  // update decision level
 	  dec_level++;
+	  // put the assignment on the trail, with the preferred phase
+	  if (phases[var] == NEGATIVE)
+	    var = get_comp_lit(var);
+	  trail_add_lit(var, DEC_ASS, NULL);
 
 	  DEBUG_MSG(fprintf(stderr, "Made decision %lu.\n",
-			    lit_to_DIMACS(which_ass)));
+			    lit_to_DIMACS(var)));
 	  DEBUG_MSG(print_model());
 	  DEBUG_MSG(print_trail());
 	  return PROPAGATE;
@@ -875,47 +6990,266 @@ int CDCL_decide()
 }
 
 
-// the simplest clause learning: DPLL-style
-// learn clauses that encode DPLL brandhing
+// learns the first UIP clause of the conflict, shrunk level by level and
+// minimized with the binary clauses of the UIP, and backjumps to the second
+// highest level in the clause, where the negated UIP is added to the trail
+// with the clause as its reason
 void CDCL_repair_conflict()
 {
+  var_set_size_t width, which_lit, which_var;
   cls_t learned_cls;
-  model_size_t which_var;
+  lit_t temp_lit;
 
   DEBUG_MSG(fprintf(stderr, "In CDCL_repair_conflict."));
   
   num_conflicts++;
   if (dec_level == 0) CDCL_report_UNSAT();
+  if (progress_interval > 0 && num_conflicts % progress_interval == 0)
+    print_progress();
+
+  num_seen_vars = 0;
+  width = analyse_conflict();
+  width = shrink_learned(width);
+  width = minimize_binary(width);
+  for (which_var = 0; which_var < num_seen_vars; which_var++)
+    seen[seen_vars[which_var]] = 0;
+  exchange_export(width);
+  proof_add(learned_lits, width);
 
-  // decision level 1 is a special case - no clause actually need be learned
-  if (dec_level != 1)
+  // put the literal of the highest remaining level second
+  for (which_lit = 2; which_lit < width; which_lit++)
+    if (model[learned_lits[which_lit]].dec_level >
+	model[learned_lits[1]].dec_level)
+      {
+	temp_lit = learned_lits[1];
+	learned_lits[1] = learned_lits[which_lit];
+	learned_lits[which_lit] = temp_lit;
+      }
+  backtrack(width > 1 ? model[learned_lits[1]].dec_level : 0);
+
+  // unit clauses are not stored, the UIP is asserted at level 0
+  if (width == 1)
     {
-      // construct the learned clause
-      learned_cls = cls_init(dec_level);
-      for (which_var = 0; which_var < num_vars; which_var++)
+      trail_add_lit(learned_lits[0], CON_ASS, NULL);
+      if (itp_filename != NULL)
+	itp_units[get_var(learned_lits[0])] = itp_learned;
+      restart_if_due();
+      return;
+    }
+
+  // with interpolation the clause has a slot for its partial interpolant
+  learned_cls = cls_init(width + (itp_filename != NULL), MEM_LEARNED);
+  learned_cls[0] = width;
+  for (which_lit = 0; which_lit < width; which_lit++)
+    learned_cls[which_lit + 1] = learned_lits[which_lit];
+  if (itp_filename != NULL)
+    *cls_itp(learned_cls) = itp_learned;
+  DEBUG_MSG(fprintf(stderr, "Learned clause: "));
+  DEBUG_MSG(cls_print(learned_cls));
+  DEBUG_MSG(fprintf(stderr, "\n"));
+  // watch the UIP and the highest level literal
+  mutable_push(&(model[get_comp_lit(learned_cls[1])].watched_lits), learned_cls);
+  mutable_push(&(model[get_comp_lit(learned_cls[2])].watched_lits), learned_cls);
+  // add clause to the formula
+  mutable_push(&learned_cnf, learned_cls);
+  trail_add_lit(learned_cls[1], CON_ASS, learned_cls);
+  restart_if_due();
+}
+
+// solves the formulas, keeping up to `width' of them interleaved, and prints
+// the result of each as it is found
+void CDCL_batch(char** filenames, int num_files, int width)
+{
+  instance_t* instances;
+  instance_t* instance;
+  int which_slot, next_file, num_active, which_step;
+  clock_t batch_start = clock();
+
+  if ((instances = (instance_t*)mem_calloc(MEM_OTHER, width, sizeof(instance_t))) == NULL)
+    error("cannot allocate batch");
+  report_returns = 1;
+  next_file = 0;
+  num_active = 0;
+  for (which_slot = 0; which_slot < width; which_slot++)
+    while (next_file < num_files && !instances[which_slot].active)
+      num_active += instance_start(instances + which_slot, filenames[next_file++]);
+
+  while (num_active > 0)
+    for (which_slot = 0; which_slot < width; which_slot++)
+      {
+	instance = instances + which_slot;
+	if (!instance->active)
+	  continue;
+	instance_load(instance);
+	if (setjmp(report_jump) == 0)
+	  {
+	    // a turn of a few steps, each a decision, or a propagated literal
+	    // and the repair of its conflict
+	    for (which_step = 0; which_step < BATCH_TURN_STEPS; which_step++)
+	      {
+		if (trail.head == trail.tail)
+		  {
+		    if (CDCL_decide() == SUCCESS)
+		      CDCL_report_SAT();
+		  }
+		else if (prop_lit() == CONFLICT)
+		  CDCL_repair_conflict();
+	      }
+	    instance_save(instance);
+	    instance_prefetch(instances + (which_slot + 1) % width,
+			      instances + (which_slot + 2) % width);
+	    continue;
+	  }
+
+	// the formula is solved, so start the next ones in its slot
+	printf("%s: %s\n", instance->filename, report_result == SAT ? "SAT" : "UNSAT");
+	CDCL_free();
+	instance->active = 0;
+	num_active--;
+	while (next_file < num_files && !instance->active)
+	  num_active += instance_start(instance, filenames[next_file++]);
+      }
+
+  fprintf(stderr, "Batch: %d formulas, %d interleaved, %1.2lfs\n", num_files,
+	  width, ((double)(clock() - batch_start)) / CLOCKS_PER_SEC);
+  report_returns = 0;
+  mem_free(instances);
+}
+
+// trims the LRAT or DRAT proof of the formula to the clauses needed for the
+// empty clause, and writes those of the formula as the unsatisfiable core
+void CDCL_trim(char* DIMACS_filename, char* proof_filename, char* trimmed_filename,
+	       char* core_filename)
+{
+  FILE* proof, *reversed, *output;
+  backward_reader_t reader;
+  unsigned char* needed = NULL, *named = NULL;
+  unsigned long max_id = 0, num_added = 0, num_kept = 0, num_deleted;
+  long id, value;
+  char* line, *cursor, *hints, empty_found = 0;
+
+  start_time = clock();
+  if ((proof = fopen(proof_filename, "rb")) == NULL)
+    error("cannot open proof");
+  if (trim_is_drat(proof))
+    {
+      fclose(proof);
+      if ((proof = tmpfile()) == NULL)
+	error("cannot create temporary proof");
+      if (!check_proof(DIMACS_filename, proof_filename, proof))
+	error("bad proof - not verified");
+      if (fflush(proof) != 0)
+	error("cannot write temporary proof");
+    }
+  if ((reversed = tmpfile()) == NULL)
+    error("cannot create temporary proof");
+  backward_init(&reader, proof);
+
+  while ((line = backward_line(&reader)) != NULL)
+    {
+      if ((cursor = trim_parse(line, &id)) == NULL)
+	continue; // an empty or comment line
+      if (id <= 0)
+	error("bad proof - clause id missing");
+
+      // ids only grow, so the last line bounds them
+      if (needed == NULL)
 	{
-	  if((model[which_var].truth_value != UNASSIGNED) &&
-	     (model[which_var].ass_type == DEC_ASS))
+	  max_id = id;
+	  if ((needed = (unsigned char*)mem_calloc(MEM_OTHER, max_id / 8 + 1, 1)) == NULL ||
+	      (named = (unsigned char*)mem_calloc(MEM_OTHER, max_id / 8 + 1, 1)) == NULL)
+	    error("cannot allocate proof marks");
+	}
+      if ((unsigned long)id > max_id)
+	error("bad proof - clause ids decrease");
+      while (*cursor == ' ' || *cursor == '\t')
+	cursor++;
+      if (*cursor == 'd')
+	continue;
+      num_added++;
+
+      // the empty clause is the last addition without literals
+      if (!empty_found)
+	{
+	  if ((cursor = trim_parse(cursor, &value)) == NULL)
+	    error("bad proof - literals missing");
+	  if (value != 0)
+	    continue;
+	  empty_found = 1;
+	  bit_set(needed, id);
+	  fprintf(reversed, "%s\n", line);
+	  for (; (cursor = trim_parse(cursor, &value)) != NULL && value != 0;)
 	    {
-	      // put the highest decision level literals first
-	      learned_cls[dec_level - model[which_var].dec_level + 1] = 
-		(model[which_var].truth_value == POSITIVE) ? 
-		get_comp_lit(which_var) : which_var;
+	      bit_set(needed, labs(value));
+	      bit_set(named, labs(value));
 	    }
+	  continue;
+	}
+      if (!bit_test(needed, id))
+	continue;
+      num_kept++;
+
+      // write the deletions of the clauses last named here, then the line,
+      // as the temporary file is reversed at the end
+      hints = trim_parse(line, &value);
+      while ((hints = trim_parse(hints, &value)) != NULL && value != 0)
+	continue;
+      if (hints == NULL)
+	error("bad proof - hints missing");
+      num_deleted = 0;
+      for (cursor = hints; (cursor = trim_parse(cursor, &value)) != NULL && value != 0;)
+	{
+	  if (labs(value) >= id)
+	    error("bad proof - hint not before its clause");
+	  if (bit_test(named, labs(value)))
+	    continue;
+	  bit_set(named, labs(value));
+	  if (num_deleted++ == 0)
+	    fprintf(reversed, "%ld d", id);
+	  fprintf(reversed, " %ld", labs(value));
 	}
-      DEBUG_MSG(fprintf(stderr, "Learned clause: "));
-      DEBUG_MSG(cls_print(learned_cls));
-      DEBUG_MSG(fprintf(stderr, "\n"));
-      // watch the highest level literals in the clause
-      mutable_push(&(model[get_comp_lit(learned_cls[1])].watched_lits), learned_cls);
-      mutable_push(&(model[get_comp_lit(learned_cls[2])].watched_lits), learned_cls);
-      // add clause to the formula
-      mutable_push(&learned_cnf, learned_cls);
-    }
-  // note that backtracking leaves the head pointing to the last decision assignment.
-  // backtrack, and add the negation of the last decision (as PROP_ASS) to the trail
-  backtrack(dec_level - 1);
-  trail_add_lit(get_comp_lit(*(trail.head) - model), CON_ASS);
+      if (num_deleted > 0)
+	fprintf(reversed, " 0\n");
+      fprintf(reversed, "%s\n", line);
+      for (cursor = hints; (cursor = trim_parse(cursor, &value)) != NULL && value != 0;)
+	bit_set(needed, labs(value));
+    }
+  if (!empty_found)
+    error("bad proof - no empty clause");
+  fclose(proof);
+  mem_free(reader.buffer);
+
+  // reverse the needed lines into the trimmed proof
+  if (fflush(reversed) != 0 || (output = fopen(trimmed_filename, "w")) == NULL)
+    error("cannot open trimmed proof");
+  backward_init(&reader, reversed);
+  while ((line = backward_line(&reader)) != NULL)
+    if (*line != '\0')
+      fprintf(output, "%s\n", line);
+  fclose(reversed);
+  mem_free(reader.buffer);
+  if (fclose(output) != 0)
+    error("cannot write trimmed proof");
+  fprintf(stderr, "Trimmed:           %lu of %lu added clauses kept\n", num_kept + 1,
+	  num_added);
+
+  trim_write_core(DIMACS_filename, core_filename, needed, max_id);
+  mem_free(needed);
+  mem_free(named);
+  fprintf(stderr, "%1.1lfs ", ((double)(clock() - start_time)) / CLOCKS_PER_SEC);
+  fprintf(stderr, "%1.1zdMb\n", getPeakRSS() / 1048576);
+}
+
+// checks the proof of the formula forwards, printing whether it is verified
+int CDCL_check(char* DIMACS_filename, char* proof_filename)
+{
+  char verified;
+
+  start_time = clock();
+  verified = check_proof(DIMACS_filename, proof_filename, NULL);
+  fprintf(stderr, "%1.1lfs ", ((double)(clock() - start_time)) / CLOCKS_PER_SEC);
+  fprintf(stderr, "%1.1zdMb\n", getPeakRSS() / 1048576);
+  return verified;
 }
 
 void CDCL_print()
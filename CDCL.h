@@ -11,14 +11,109 @@
 #define SUCCESS 3
 
 typedef unsigned char state_t;
-state_t state;
+extern state_t state;
 
 // the current decision level is global
 typedef unsigned long int dec_level_t;
-dec_level_t dec_level;
+extern dec_level_t dec_level;
 
 // initialises the solver into default state based on the given DIMACS file
 void CDCL_init(char* DIMACS_filename);
+// before CDCL_init: computes a Craig interpolant of the first num_a clauses of
+// the formula and the rest, and writes it to the given file as binary AIGER if
+// the formula is UNSAT. preprocessing, the result cache and the portfolio are
+// not used
+void CDCL_interpolate(unsigned long num_a, char* aiger_filename);
+// before CDCL_init: writes a DRAT proof to the given file, which ends
+// with the empty clause if the formula is UNSAT. preprocessing writes its
+// steps to the proof, while the portfolio is not used. an UNSAT result is
+// answered from the cache only with the proof stored with it
+void CDCL_proof(char* proof_filename);
+// answers the formula from the result cache in the given directory if it holds
+// the same formula up to the order of clauses and literals, and otherwise
+// stores the result there once found. the least recently used entries are
+// evicted beyond the given number of entries or bytes, 0 for no limit
+void CDCL_cache(char* directory, unsigned long max_entries, unsigned long max_bytes);
+// extracts cheap features of the formula (size, clause widths, variable
+// degrees, literal balance and a few probes) and picks the decision order,
+// phases, restarts and preprocessing passes of the nearest centroid of the
+// selection model in the given file, or of the built-in model if NULL
+void CDCL_select(char* model_filename);
+// simplifies the formula at decision level 0: at-most-one encodings are lifted
+// into native constraints, equivalent variables are found by sweeping and
+// substituted, the clauses satisfied by an autarky are removed, and variables
+// are eliminated by bounded variable elimination, using gate definitions where
+// found
+void CDCL_preprocess();
+// looks for a satisfying assignment with cheap strategies before the search:
+// all variables false or true, and deciding them false or true in forward or
+// backward order with propagation. reports SAT if one succeeds
+void CDCL_lucky();
+// on formulas of at most a few hundred variables, runs hundreds of random
+// descents with unit propagation at once, one per bit of a machine word, for
+// the given number of rounds per variable, one decision each. stops early when
+// every descent conflicts from level 0. reports SAT if one of them satisfies
+// the formula
+void CDCL_slice(unsigned long rounds_per_var);
+// runs the given number of local search walkers in parallel threads for a
+// bounded time, and reports SAT if one of them satisfies the formula
+void CDCL_walk(int num_walkers);
+// forks the given number of worker processes, which search with different
+// phases and decision orders and share short learned clauses. returns in
+// every worker; the parent process exits once the first worker has reported
+void CDCL_portfolio(int workers);
+// solves the given formulas one after the other, interleaving the search of up
+// to `width' of them in a single thread, and prints the result of each
+void CDCL_batch(char** filenames, int num_files, int width);
+// incremental use: after CDCL_incremental, CDCL_init and CDCL_preprocess,
+// clauses may be added and the formula solved any number of times.
+// CDCL_preprocess may be called again between solves, and leaves an
+// unsatisfiable formula to CDCL_solve instead of reporting it. a frozen
+// variable is never removed by simplification, and an eliminated variable that
+// is frozen or used by a new clause is brought back. freezes are counted and
+// undone by as many melts
+void CDCL_incremental();
+void CDCL_freeze(long DIMACS_lit);
+void CDCL_melt(long DIMACS_lit);
+void CDCL_add_clause(long* DIMACS_lits, int width);
+// returns 1 if the formula is SAT and 0 if it is UNSAT, without exiting
+int CDCL_solve();
+// returns 1 if the literal is true in the model of the last SAT result, -1 if
+// false and 0 if unassigned
+int CDCL_value(long DIMACS_lit);
+// assumes the literal for the next CDCL_solve only. an UNSAT result caused by
+// the assumptions leaves the formula satisfiable for later calls
+void CDCL_assume(long DIMACS_lit);
+// checks the bad state property of an AIGER circuit (the first bad state
+// literal, or the first output) up to the given bound, unrolling it into one
+// incremental solver that keeps its learned clauses from bound to bound. prints
+// u<k> for each bound k without a counterexample, then the AIGER witness of a
+// counterexample, or 2 for unknown once the bound is reached
+void CDCL_bmc(char* aiger_filename, unsigned long max_bound);
+// experimental: splits the watch list of a literal with many watchers between
+// the given number of threads, which visit it at once against the assignment
+// before it is propagated. the outcome does not depend on the number of
+// threads
+void CDCL_parallel_prop(int num_threads);
+// prints a progress line every given number of conflicts, with the memory
+// allocated by each subsystem
+void CDCL_progress(unsigned long interval);
+// makes SIGUSR1 request the statistics and the state of the search (level,
+// trail size, learned clauses), which CDCL_poll_stats prints if requested
+// since the last call. the search goes on
+void CDCL_stats_signal();
+void CDCL_poll_stats();
+// trims an LRAT proof of the formula to the clauses needed for the empty
+// clause, reading it backwards with bounded memory, and writes the trimmed
+// proof and the unsatisfiable core as DIMACS. a DRAT proof without RAT steps
+// is checked and written as LRAT first, so the trimmed proof is LRAT. the
+// indices of the core clauses in the formula, counted from 1, are printed to
+// standard output
+void CDCL_trim(char* DIMACS_filename, char* proof_filename, char* trimmed_filename,
+	       char* core_filename);
+// checks a DRAT proof of the formula without RAT steps forwards, every added
+// clause by unit propagation, and returns 1 if it adds the empty clause
+int CDCL_check(char* DIMACS_filename, char* proof_filename);
 // deallocates all memory allocated during the CDCL process
 void CDCL_free();
 // looks for unit clauses under the assignment in the solver's model, and adds 
@@ -27,8 +122,8 @@ state_t CDCL_prop();
 // looks for a single unit clause, and returns the fist it finds, or NULL if
 // none is to be found
 int CDCL_decide();
-// learns a clause after conflict, currently this is just the negation of the decision
-// assignment
+// learns the first UIP clause after conflict, shrinks it, and backjumps to the
+// level where it asserts the negation of the UIP
 void CDCL_repair_conflict();
 // prints the entire contents of the solver
 void CDCL_print();
@@ -4,13 +4,130 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "CDCL.h"
 
 int main(int argc, char** argv)
 {  
-  CDCL_init(argv[1]);
-  if(state == PROPAGATE)
-    CDCL_prop();
+  char** filenames;
+  int num_files = 0;
+  int num_walkers = 0;
+  unsigned long slice_rounds = 0;
+  int num_workers = 0;
+  int num_prop_threads = 1;
+  int batch_width = 0;
+  char* cache_dir = NULL;
+  char* selection_model = NULL;
+  unsigned long cache_entries = 4096;
+  unsigned long cache_megabytes = 256;
+  unsigned long progress_interval = 0;
+  char* trim_files[3] = {NULL, NULL, NULL};
+  char* interpolant_file = NULL;
+  char* proof_file = NULL;
+  char* checked_file = NULL;
+  unsigned long num_a_clauses = 0;
+  long bmc_bound = -1;
+  int which_arg;
+
+  // read the options and the formulas
+  if ((filenames = (char**)malloc(sizeof(char*) * argc)) == NULL)
+    return 1;
+  for (which_arg = 1; which_arg < argc; which_arg++)
+    {
+      if (strcmp(argv[which_arg], "-w") == 0 && which_arg + 1 < argc)
+	num_walkers = atoi(argv[++which_arg]);
+      else if (strcmp(argv[which_arg], "-l") == 0 && which_arg + 1 < argc)
+	slice_rounds = strtoul(argv[++which_arg], NULL, 10);
+      else if (strcmp(argv[which_arg], "-p") == 0 && which_arg + 1 < argc)
+	num_workers = atoi(argv[++which_arg]);
+      else if (strcmp(argv[which_arg], "-u") == 0 && which_arg + 1 < argc)
+	num_prop_threads = atoi(argv[++which_arg]);
+      else if (strcmp(argv[which_arg], "-b") == 0 && which_arg + 1 < argc)
+	batch_width = atoi(argv[++which_arg]);
+      else if (strcmp(argv[which_arg], "-t") == 0 && which_arg + 3 < argc)
+	{
+	  trim_files[0] = argv[++which_arg];
+	  trim_files[1] = argv[++which_arg];
+	  trim_files[2] = argv[++which_arg];
+	}
+      else if (strcmp(argv[which_arg], "-k") == 0 && which_arg + 1 < argc)
+	bmc_bound = atol(argv[++which_arg]);
+      else if (strcmp(argv[which_arg], "-i") == 0 && which_arg + 2 < argc)
+	{
+	  num_a_clauses = strtoul(argv[++which_arg], NULL, 10);
+	  interpolant_file = argv[++which_arg];
+	}
+      else if (strcmp(argv[which_arg], "-d") == 0 && which_arg + 1 < argc)
+	proof_file = argv[++which_arg];
+      else if (strcmp(argv[which_arg], "-V") == 0 && which_arg + 1 < argc)
+	checked_file = argv[++which_arg];
+      else if (strcmp(argv[which_arg], "-v") == 0 && which_arg + 1 < argc)
+	progress_interval = strtoul(argv[++which_arg], NULL, 10);
+      else if (strcmp(argv[which_arg], "-s") == 0 && which_arg + 1 < argc)
+	selection_model = argv[++which_arg];
+      else if (strcmp(argv[which_arg], "-c") == 0 && which_arg + 1 < argc)
+	cache_dir = argv[++which_arg];
+      else if (strcmp(argv[which_arg], "-C") == 0 && which_arg + 1 < argc)
+	cache_entries = strtoul(argv[++which_arg], NULL, 10);
+      else if (strcmp(argv[which_arg], "-M") == 0 && which_arg + 1 < argc)
+	cache_megabytes = strtoul(argv[++which_arg], NULL, 10);
+      else
+	filenames[num_files++] = argv[which_arg];
+    }
+  if (batch_width > 0 && num_files > 0)
+    {
+      CDCL_batch(filenames, num_files, batch_width);
+      free(filenames);
+      return 0;
+    }
+  if (trim_files[0] != NULL && num_files == 1)
+    {
+      CDCL_trim(filenames[0], trim_files[0], trim_files[1], trim_files[2]);
+      free(filenames);
+      return 0;
+    }
+  if (checked_file != NULL && num_files == 1)
+    {
+      which_arg = CDCL_check(filenames[0], checked_file);
+      free(filenames);
+      return !which_arg;
+    }
+  if (bmc_bound >= 0 && num_files == 1)
+    {
+      CDCL_bmc(filenames[0], bmc_bound);
+      free(filenames);
+      return 0;
+    }
+  if (num_files != 1)
+    {
+      fprintf(stderr, "usage: CDCL [-l <rounds>] [-w <walkers>] [-p <workers>] [-u <threads>] [-s <model>] [-v <conflicts>] [-c <cache-dir> "
+	      "[-C <entries>] [-M <megabytes>]] [-i <a-clauses> <aiger-file>] [-d <drat-proof>] <path-to-formula>\n"
+	      "       CDCL -b <width> <path-to-formula> ...\n"
+	      "       CDCL -t <proof> <trimmed-proof> <core> <path-to-formula>\n"
+	      "       CDCL -V <drat-proof> <path-to-formula>\n"
+	      "       CDCL -k <bound> <path-to-aiger>\n");
+      return 1;
+    }
+
+  CDCL_progress(progress_interval);
+  CDCL_parallel_prop(num_prop_threads);
+  CDCL_stats_signal();
+  if (interpolant_file != NULL)
+    CDCL_interpolate(num_a_clauses, interpolant_file);
+  if (proof_file != NULL)
+    CDCL_proof(proof_file);
+  CDCL_init(filenames[0]);
+  if (cache_dir != NULL)
+    CDCL_cache(cache_dir, cache_entries, cache_megabytes << 20);
+  CDCL_select(selection_model);
+  CDCL_preprocess();
+  CDCL_lucky();
+  if (slice_rounds > 0)
+    CDCL_slice(slice_rounds);
+  if (num_walkers > 0)
+    CDCL_walk(num_walkers);
+  if (num_workers > 1)
+    CDCL_portfolio(num_workers);
 
   while(CDCL_decide() != SUCCESS)
     {
@@ -18,6 +135,7 @@ int main(int argc, char** argv)
 	{
 	  CDCL_repair_conflict();	    
 	}
+      CDCL_poll_stats();
     }
   CDCL_report_SAT();
   // CDCL_free(); not needed as the previous line exits